@@ -2,13 +2,132 @@
 // SPDX-License-Identifier: BSL-1.0
 
 #include <Pothos/Framework.hpp>
+#include <Pothos/Testing.hpp>
+#include "ChatMessageModel.hpp"
+#include "ChatJournal.hpp"
 #include <QHBoxLayout>
 #include <QVBoxLayout>
 #include <QTextEdit>
+#include <QListView>
 #include <QLineEdit>
 #include <QLabel>
 #include <QScrollBar>
+#include <QDateTime>
 #include <iostream>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <vector>
+#include <mutex>
+#include <algorithm> //max
+#include <cstring> //memcpy
+
+/***********************************************************************
+ * Encode UTF-16 into UTF-8 directly into the output memory.
+ * The output must have room for 3 bytes per UTF-16 code unit.
+ * Unpaired surrogates are replaced with U+FFFD.
+ **********************************************************************/
+static size_t encodeUtf8(const QString &str, char *out)
+{
+    auto p = reinterpret_cast<unsigned char *>(out);
+    const ushort *in = str.utf16();
+    const int n = str.size();
+    for (int i = 0; i < n; i++)
+    {
+        uint c = in[i];
+        if (c < 0x80)
+        {
+            *p++ = uchar(c);
+            continue;
+        }
+        if (c < 0x800)
+        {
+            *p++ = uchar(0xc0 | (c >> 6));
+            *p++ = uchar(0x80 | (c & 0x3f));
+            continue;
+        }
+        if (QChar::isHighSurrogate(c) and i+1 < n and QChar::isLowSurrogate(in[i+1]))
+        {
+            c = QChar::surrogateToUcs4(ushort(c), in[++i]);
+            *p++ = uchar(0xf0 | (c >> 18));
+            *p++ = uchar(0x80 | ((c >> 12) & 0x3f));
+            *p++ = uchar(0x80 | ((c >> 6) & 0x3f));
+            *p++ = uchar(0x80 | (c & 0x3f));
+            continue;
+        }
+        if (QChar::isSurrogate(c)) c = QChar::ReplacementCharacter;
+        *p++ = uchar(0xe0 | (c >> 12));
+        *p++ = uchar(0x80 | ((c >> 6) & 0x3f));
+        *p++ = uchar(0x80 | (c & 0x3f));
+    }
+    return size_t(p - reinterpret_cast<unsigned char *>(out));
+}
+
+//the most journal messages replayed when the chat window keeps unlimited messages
+static const size_t MAX_JOURNAL_REPLAY = 10000;
+
+/***********************************************************************
+ * Format a hex dump row of up to 16 bytes into the output memory:
+ * "00000010  00 11 22 33 44 55 66 77  88 99 aa bb cc dd ee ff  |..\"3DUfw........|"
+ * Every row has the same width, missing bytes are padded with spaces.
+ **********************************************************************/
+static const size_t HEX_ROW_BYTES = 16;
+static const size_t HEX_ROW_WIDTH = 8+2+HEX_ROW_BYTES*3+1+1+HEX_ROW_BYTES+2;
+
+struct HexTable
+{
+    HexTable(void)
+    {
+        static const char digits[] = "0123456789abcdef";
+        for (size_t i = 0; i < 256; i++)
+        {
+            pairs[i*2+0] = digits[i >> 4];
+            pairs[i*2+1] = digits[i & 0xf];
+            ascii[i] = (i >= 0x20 and i < 0x7f)? char(i) : '.';
+        }
+    }
+    char pairs[512];
+    char ascii[256];
+};
+
+static size_t formatHexRow(char *out, const size_t offset, const unsigned char *data, const size_t len)
+{
+    static const HexTable table;
+    char *p = out;
+    for (int shift = 24; shift >= 0; shift -= 8)
+    {
+        std::memcpy(p, table.pairs+((offset >> shift) & 0xff)*2, 2);
+        p += 2;
+    }
+    *p++ = ' ';
+    for (size_t i = 0; i < HEX_ROW_BYTES; i++)
+    {
+        if (i == HEX_ROW_BYTES/2) *p++ = ' ';
+        *p++ = ' ';
+        if (i < len) std::memcpy(p, table.pairs+data[i]*2, 2);
+        else std::memset(p, ' ', 2);
+        p += 2;
+    }
+    *p++ = ' ';
+    *p++ = ' ';
+    *p++ = '|';
+    for (size_t i = 0; i < HEX_ROW_BYTES; i++) *p++ = (i < len)? table.ascii[data[i]] : ' ';
+    *p++ = '|';
+    return size_t(p - out);
+}
+
+POTHOS_TEST_BLOCK("/widgets/tests", test_chat_box_hex_row)
+{
+    const std::string data("\x00\x11\"3DUfw\x88\x99\xaa\xbb\xcc\xdd\xee\xff", 16);
+    char row[HEX_ROW_WIDTH];
+    POTHOS_TEST_EQUAL(formatHexRow(row, 0x10, reinterpret_cast<const unsigned char *>(data.data()), 16), HEX_ROW_WIDTH);
+    POTHOS_TEST_EQUAL(std::string(row, HEX_ROW_WIDTH),
+        "00000010  00 11 22 33 44 55 66 77  88 99 aa bb cc dd ee ff  |..\"3DUfw........|");
+
+    POTHOS_TEST_EQUAL(formatHexRow(row, 0x12345678, reinterpret_cast<const unsigned char *>("AB"), 2), HEX_ROW_WIDTH);
+    POTHOS_TEST_EQUAL(std::string(row, HEX_ROW_WIDTH),
+        "12345678  41 42                                             |AB              |");
+}
 
 /***********************************************************************
  * |PothosDoc Chat Box
@@ -20,12 +139,43 @@
  * The chat box has an input port for accepting packet messages,
  * and an output port for producing packet messages from the user.
  * The message packets contain a buffer formatted as a UTF8 string.
+ * The sender's details are carried in the packet metadata:
+ * "username" and "color" strings, and a "timestamp" in milliseconds since the epoch.
+ * Messages with a timestamp are displayed with a "[hh:mm:ss]" prefix in local time.
+ * Packets without a username in the metadata are displayed as rich text
+ * for compatibility with older chat boxes that embedded the formatting in the payload.
  *
  * The user's text from the entry box will be echoed to the chat window
  * and a message will be posted to the output port as a packet message.
  * Messages arriving at the input port will be converted to a string
  * and displayed to the chat window.
  *
+ * The chat window keeps a bounded scrollback history.
+ * When the line or byte budget is exceeded, the oldest messages are removed.
+ * The current size of the history is available from the
+ * getScrollbackLines() and getScrollbackBytes() calls.
+ *
+ * Incoming messages are drained in batches and appended to the chat window
+ * with a single update per GUI event loop iteration.
+ * The getLastBatchSize() and getAverageBatchSize() calls
+ * report how many messages were merged into each update.
+ *
+ * The chat window can be displayed as rich text or as a message list.
+ * The message list stores messages compactly and only draws the visible rows,
+ * which keeps scrolling fast for very long sessions.
+ *
+ * The chat history can be kept in a journal file that survives restarts.
+ * Messages are appended to the journal in batches by a background thread.
+ * When the journal is opened, the chat window is cleared and the journal's most recent messages
+ * (up to max lines and max bytes, or 10000 messages for unlimited lines)
+ * are replayed into the chat window in the background, so a large journal
+ * does not delay the activation of the topology.
+ *
+ * For inspecting binary packets, the payload mode can be set to hex dump.
+ * Each incoming payload is then displayed as rows of offset, hex bytes, and ASCII characters.
+ * The dump is formatted in the block's thread, and limited to the first dump bytes of the payload,
+ * so that large packets at high rates do not stall the chat window.
+ *
  * |category /Widgets
  * |keywords message chat IM
  *
@@ -38,10 +188,51 @@
  * |default "blue"
  * |preview disable
  *
+ * |param maxLines [Max Lines] The maximum number of messages kept in the chat window.
+ * Use 0 for an unlimited number of messages.
+ * |default 10000
+ * |preview disable
+ *
+ * |param maxBytes [Max Bytes] The approximate memory budget for messages in the chat window.
+ * Use 0 for an unlimited memory budget.
+ * |units bytes
+ * |default 16777216
+ * |preview disable
+ *
+ * |param displayMode [Display Mode] How messages are rendered in the chat window.
+ * |default "RICHTEXT"
+ * |option [Rich Text] "RICHTEXT"
+ * |option [Message List] "LIST"
+ * |preview disable
+ *
+ * |param journalPath [Journal Path] The path to an append-only chat history journal.
+ * Leave empty to keep the history in memory only.
+ * |default ""
+ * |widget FileEntry(mode=save)
+ * |preview valid
+ *
+ * |param payloadMode [Payload Mode] How incoming packet payloads are interpreted.
+ * |default "TEXT"
+ * |option [Text] "TEXT"
+ * |option [Hex Dump] "HEX"
+ * |preview disable
+ *
+ * |param dumpBytes [Dump Bytes] The maximum number of payload bytes shown per packet in hex dump mode.
+ * Use 0 to show the entire payload.
+ * |units bytes
+ * |default 256
+ * |preview when(enum=payloadMode, "HEX")
+ *
  * |mode graphWidget
  * |factory /widgets/chat_box()
  * |setter setUsername(username)
  * |setter setColor(color)
+ * |setter setMaxLines(maxLines)
+ * |setter setMaxBytes(maxBytes)
+ * |setter setDisplayMode(displayMode)
+ * |setter setJournalPath(journalPath)
+ * |setter setPayloadMode(payloadMode)
+ * |setter setDumpBytes(dumpBytes)
  **********************************************************************/
 class ChatBox : public QWidget, public Pothos::Block
 {
@@ -55,18 +246,41 @@ public:
 
     ChatBox(void):
         _chatDisplay(new QTextEdit(this)),
+        _chatList(new QListView(this)),
+        _chatModel(new ChatMessageModel(this)),
         _chatEntry(new QLineEdit(this)),
-        _userLabel(new QLabel(this))
+        _userLabel(new QLabel(this)),
+        _listMode(false),
+        _hexMode(false),
+        _dumpBytes(0),
+        _maxLines(0),
+        _maxBytes(0),
+        _scrollbackLines(0),
+        _scrollbackBytes(0),
+        _flushPending(false),
+        _lastBatchSize(0),
+        _totalBatches(0),
+        _totalBatchedLines(0)
     {
         //layout
         auto vlayout = new QVBoxLayout(this);
         auto hlayout = new QHBoxLayout();
         vlayout->addWidget(_chatDisplay);
+        vlayout->addWidget(_chatList);
         vlayout->addLayout(hlayout);
         hlayout->addWidget(_userLabel);
         hlayout->addWidget(_chatEntry);
 
         _chatDisplay->setReadOnly(true);
+        _chatDisplay->setUndoRedoEnabled(false);
+
+        //uniform rows let the list view skip layout of rows that are not visible
+        _chatList->setModel(_chatModel);
+        _chatList->setItemDelegate(new ChatMessageDelegate(_chatList));
+        _chatList->setUniformItemSizes(true);
+        _chatList->setEditTriggers(QAbstractItemView::NoEditTriggers);
+        _chatList->setSelectionMode(QAbstractItemView::ExtendedSelection);
+        _chatList->hide();
 
         //widget signals
         connect(_chatEntry, &QLineEdit::returnPressed, this, &ChatBox::handleEntry);
@@ -75,6 +289,16 @@ public:
         this->registerCall(this, POTHOS_FCN_TUPLE(ChatBox, widget));
         this->registerCall(this, POTHOS_FCN_TUPLE(ChatBox, setUsername));
         this->registerCall(this, POTHOS_FCN_TUPLE(ChatBox, setColor));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ChatBox, setMaxLines));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ChatBox, setMaxBytes));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ChatBox, setDisplayMode));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ChatBox, setJournalPath));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ChatBox, setPayloadMode));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ChatBox, setDumpBytes));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ChatBox, getScrollbackLines));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ChatBox, getScrollbackBytes));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ChatBox, getLastBatchSize));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ChatBox, getAverageBatchSize));
 
         //ports
         this->setupInput("in");
@@ -98,46 +322,285 @@ public:
         _color = color;
     }
 
+    void setMaxLines(const size_t maxLines)
+    {
+        _maxLines = maxLines;
+        QMetaObject::invokeMethod(this, "evictLines", Qt::QueuedConnection);
+    }
+
+    void setMaxBytes(const size_t maxBytes)
+    {
+        _maxBytes = maxBytes;
+        QMetaObject::invokeMethod(this, "evictLines", Qt::QueuedConnection);
+    }
+
+    void setDisplayMode(const QString &mode)
+    {
+        if (mode != "RICHTEXT" and mode != "LIST") throw Pothos::InvalidArgumentException("ChatBox::setDisplayMode("+mode.toStdString()+")", "unknown display mode");
+        QMetaObject::invokeMethod(this, "handleSetDisplayMode", Qt::QueuedConnection, Q_ARG(bool, mode == "LIST"));
+    }
+
+    void setJournalPath(const QString &path)
+    {
+        //close the previous journal before opening the same file again
+        this->setJournal(nullptr);
+        if (path.isEmpty()) return;
+
+        //the window shows the replayed history once, even when the same journal is opened again,
+        //so drop the messages not yet shown and clear the window before the replay is posted
+        {
+            std::lock_guard<std::mutex> lock(_pendingMutex);
+            _pendingMessages.clear();
+        }
+        QMetaObject::invokeMethod(this, "handleClearHistory", Qt::QueuedConnection);
+
+        //the replay is bounded even when the chat window keeps unlimited messages
+        const auto maxLines = _maxLines.load();
+        this->setJournal(std::make_shared<ChatJournal>(path, (maxLines == 0)? MAX_JOURNAL_REPLAY : maxLines, _maxBytes.load(),
+            [this](const std::vector<ChatMessage> &messages)
+        {
+            this->postMessages(messages);
+        }));
+    }
+
+    void setPayloadMode(const QString &mode)
+    {
+        if (mode != "TEXT" and mode != "HEX") throw Pothos::InvalidArgumentException("ChatBox::setPayloadMode("+mode.toStdString()+")", "unknown payload mode");
+        _hexMode = (mode == "HEX");
+    }
+
+    void setDumpBytes(const size_t dumpBytes)
+    {
+        _dumpBytes = dumpBytes;
+    }
+
+    size_t getScrollbackLines(void) const
+    {
+        return _scrollbackLines.load();
+    }
+
+    size_t getScrollbackBytes(void) const
+    {
+        return _scrollbackBytes.load();
+    }
+
+    size_t getLastBatchSize(void) const
+    {
+        return _lastBatchSize.load();
+    }
+
+    double getAverageBatchSize(void) const
+    {
+        const auto batches = _totalBatches.load();
+        if (batches == 0) return 0.0;
+        return double(_totalBatchedLines.load())/batches;
+    }
+
     void work(void)
     {
+        //drain every available message, then hand the GUI a single batch
         auto inPort = this->input("in");
-        if (inPort->hasMessage())
+        std::vector<ChatMessage> messages;
+        while (inPort->hasMessage())
         {
-            auto msg = inPort->popMessage();
-            auto pkt = msg.extract<Pothos::Packet>();
-            const QByteArray bytes(pkt.payload.as<const char *>(), pkt.payload.length);
-            const QString line(bytes);
-            QMetaObject::invokeMethod(this, "handleIncomingLine", Qt::QueuedConnection, Q_ARG(QString, line));
+            //decode straight from the payload memory
+            const auto msg = inPort->popMessage();
+            const auto &pkt = msg.extract<Pothos::Packet>();
+            if (_hexMode)
+            {
+                this->appendHexDump(messages, pkt.payload);
+                continue;
+            }
+            ChatMessage message;
+            message.text = QString::fromUtf8(pkt.payload.as<const char *>(), int(pkt.payload.length));
+            message.isHtml = not metadataString(pkt.metadata, "username", message.username);
+            metadataString(pkt.metadata, "color", message.color);
+            const auto it = pkt.metadata.find("timestamp");
+            if (it != pkt.metadata.end() and it->second.canConvert(typeid(qint64)))
+            {
+                message.timestamp = it->second.convert<qint64>();
+            }
+            messages.push_back(message);
         }
+        if (messages.empty()) return;
+
+        const auto journal = this->getJournal();
+        if (journal) journal->append(messages);
+        this->postMessages(messages);
     }
 
 private slots:
     void handleEntry(void)
     {
-        auto text = _chatEntry->text();
+        ChatMessage message;
+        message.username = _username;
+        message.color = _color;
+        message.text = _chatEntry->text();
+        message.timestamp = QDateTime::currentMSecsSinceEpoch();
         _chatEntry->setText("");
-        const auto line = QString("<font color=\"%1\"><b>%2:</b></font> %3")
-            .arg(_color)
-            .arg(_username.toHtmlEscaped())
-            .arg(text.toHtmlEscaped());
 
-        this->handleIncomingLine(line);
+        this->appendMessages(std::vector<ChatMessage>(1, message));
+        const auto journal = this->getJournal();
+        if (journal) journal->append(std::vector<ChatMessage>(1, message));
         if (this->isActive())
         {
-            const auto bytes = line.toUtf8();
-            const auto sharedBuff = std::make_shared<QByteArray>(bytes);
             Pothos::Packet pkt;
-            pkt.payload = Pothos::SharedBuffer(size_t(bytes.data()), bytes.size(), sharedBuff);
+            pkt.payload = this->makeUtf8Payload(message.text);
+            pkt.metadata["username"] = Pothos::Object(message.username.toStdString());
+            pkt.metadata["color"] = Pothos::Object(message.color.toStdString());
+            pkt.metadata["timestamp"] = Pothos::Object(message.timestamp);
             auto outPort = this->output("out");
             outPort->postMessage(pkt);
         }
     }
 
-    void handleIncomingLine(const QString &line)
+    void handleIncomingMessages(void)
+    {
+        std::vector<ChatMessage> messages;
+        {
+            std::lock_guard<std::mutex> lock(_pendingMutex);
+            messages.swap(_pendingMessages);
+            _flushPending = false;
+        }
+        _lastBatchSize = messages.size();
+        _totalBatches++;
+        _totalBatchedLines += messages.size();
+        this->appendMessages(messages);
+    }
+
+    void handleSetDisplayMode(const bool listMode)
     {
+        if (listMode == _listMode) return;
+        _listMode = listMode;
+        _chatDisplay->setVisible(not _listMode);
+        _chatList->setVisible(_listMode);
+
+        //the history is not carried over between display modes
+        this->handleClearHistory();
+    }
+
+    void handleClearHistory(void)
+    {
+        _chatDisplay->clear();
+        _scrollback.clear();
+        _scrollbackBytes = 0;
+        _chatModel->clear();
+        this->evictLines();
+    }
+
+    void evictLines(void)
+    {
+        if (_listMode)
+        {
+            _chatModel->evict(_maxLines, _maxBytes);
+            _scrollbackLines = _chatModel->size();
+            _scrollbackBytes = _chatModel->bytes();
+            return;
+        }
+
+        //remove the oldest messages from the start of the document, the newest message is always kept
+        while (_scrollback.size() > 1 and (
+            (_maxLines != 0 and _scrollback.size() > _maxLines) or
+            (_maxBytes != 0 and _scrollbackBytes > _maxBytes)))
+        {
+            const auto &oldest = _scrollback.front();
+            QTextCursor c(_chatDisplay->document()->firstBlock());
+            c.movePosition(QTextCursor::NextBlock, QTextCursor::KeepAnchor, oldest.blocks);
+            c.removeSelectedText();
+            _scrollbackBytes -= oldest.bytes;
+            _scrollback.pop_front();
+        }
+        _scrollbackLines = _scrollback.size();
+    }
+
+private:
+
+    //hand a batch of messages to the GUI thread, safe to call from any thread
+    void postMessages(const std::vector<ChatMessage> &messages)
+    {
+        std::lock_guard<std::mutex> lock(_pendingMutex);
+        _pendingMessages.insert(_pendingMessages.end(), messages.begin(), messages.end());
+        if (_flushPending) return;
+        _flushPending = true;
+        QMetaObject::invokeMethod(this, "handleIncomingMessages", Qt::QueuedConnection);
+    }
+
+    std::shared_ptr<ChatJournal> getJournal(void)
+    {
+        std::lock_guard<std::mutex> lock(_journalMutex);
+        return _journal;
+    }
+
+    void setJournal(std::shared_ptr<ChatJournal> journal)
+    {
+        std::lock_guard<std::mutex> lock(_journalMutex);
+        _journal = journal;
+    }
+
+    static bool metadataString(const Pothos::ObjectKwargs &metadata, const std::string &key, QString &value)
+    {
+        const auto it = metadata.find(key);
+        if (it == metadata.end() or not it->second.canConvert(typeid(QString))) return false;
+        value = it->second.convert<QString>();
+        return true;
+    }
+
+    void appendHexDump(std::vector<ChatMessage> &messages, const Pothos::BufferChunk &payload)
+    {
+        const auto data = payload.as<const unsigned char *>();
+        const size_t total = payload.length;
+        const size_t dumpBytes = _dumpBytes;
+        const size_t length = (dumpBytes == 0)? total : std::min(total, dumpBytes);
+
+        char row[HEX_ROW_WIDTH];
+        ChatMessage message;
+        message.isMonospace = true;
+        for (size_t offset = 0; offset < length; offset += HEX_ROW_BYTES)
+        {
+            const size_t len = formatHexRow(row, offset, data+offset, std::min(HEX_ROW_BYTES, length-offset));
+            message.text = QString::fromLatin1(row, int(len));
+            messages.push_back(message);
+        }
+
+        if (length == total) return;
+        message.isMonospace = false;
+        message.text = QString("(%1 of %2 bytes shown)").arg(length).arg(total);
+        messages.push_back(message);
+    }
+
+    Pothos::BufferChunk makeUtf8Payload(const QString &text)
+    {
+        //reuse the previous payload memory once downstream has released it
+        const size_t maxBytes = size_t(text.size())*3;
+        if (_outBuffer.length < maxBytes or not _outBuffer.unique())
+        {
+            _outBuffer = Pothos::BufferChunk(std::max<size_t>(maxBytes, 1024));
+        }
+        auto payload = _outBuffer;
+        payload.length = encodeUtf8(text, payload.as<char *>());
+        return payload;
+    }
+
+    void appendMessages(const std::vector<ChatMessage> &messages)
+    {
+        if (_listMode)
+        {
+            const auto scrollBar = _chatList->verticalScrollBar();
+            const bool autoScroll = scrollBar->value()+50 > scrollBar->maximum();
+            _chatModel->append(messages);
+            this->evictLines();
+            if (autoScroll) _chatList->scrollToBottom();
+            return;
+        }
+
         const bool autoScroll = _chatDisplay->verticalScrollBar()->value()+50 > _chatDisplay->verticalScrollBar()->maximum();
 
-        _chatDisplay->insertHtml(line+"<br />");
+        //one edit block so the document is laid out once per batch
+        QTextCursor batch(_chatDisplay->document());
+        batch.beginEditBlock();
+        for (const auto &message : messages) this->appendLine(message.toHtml());
+        this->evictLines();
+        batch.endEditBlock();
 
         if (autoScroll)
         {
@@ -147,12 +610,58 @@ private slots:
         }
     }
 
-private:
+    void appendLine(const QString &line)
+    {
+        //each message is appended as its own block so it can be removed as a unit
+        auto doc = _chatDisplay->document();
+        const int blocksBefore = _scrollback.empty()? 0 : doc->blockCount();
+        QTextCursor c(doc);
+        c.movePosition(QTextCursor::End);
+        if (not _scrollback.empty()) c.insertBlock();
+        c.insertHtml(line);
+
+        ScrollbackEntry entry;
+        entry.blocks = doc->blockCount() - blocksBefore;
+        entry.bytes = size_t(line.size())*sizeof(QChar);
+        _scrollback.push_back(entry);
+        _scrollbackBytes += entry.bytes;
+    }
+
     QTextEdit *_chatDisplay;
+    QListView *_chatList;
+    ChatMessageModel *_chatModel;
     QLineEdit *_chatEntry;
     QLabel *_userLabel;
     QString _username;
     QString _color;
+    Pothos::BufferChunk _outBuffer;
+    bool _listMode;
+    std::atomic<bool> _hexMode;
+    std::atomic<size_t> _dumpBytes;
+
+    //scrollback budget and accounting
+    struct ScrollbackEntry
+    {
+        int blocks;
+        size_t bytes;
+    };
+    std::deque<ScrollbackEntry> _scrollback;
+    std::atomic<size_t> _maxLines;
+    std::atomic<size_t> _maxBytes;
+    std::atomic<size_t> _scrollbackLines;
+    std::atomic<size_t> _scrollbackBytes;
+
+    //batched hand-off of incoming messages to the GUI thread
+    std::mutex _pendingMutex;
+    std::vector<ChatMessage> _pendingMessages;
+    bool _flushPending;
+    std::atomic<size_t> _lastBatchSize;
+    std::atomic<unsigned long long> _totalBatches;
+    std::atomic<unsigned long long> _totalBatchedLines;
+
+    //declared last so the journal thread stops before the state it posts to is destroyed
+    std::mutex _journalMutex;
+    std::shared_ptr<ChatJournal> _journal;
 };
 
 static Pothos::BlockRegistry registerChatBox(
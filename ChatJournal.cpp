@@ -0,0 +1,274 @@
+// Copyright (c) 2026 agent
+// SPDX-License-Identifier: BSL-1.0
+
+#include "ChatJournal.hpp"
+#include <Pothos/Exception.hpp>
+#include <Pothos/Testing.hpp>
+#include <QTemporaryDir>
+#include <QDataStream>
+#include <QtEndian>
+#include <QFile>
+#include <algorithm> //reverse
+
+static const size_t REPLAY_CHUNK_SIZE = 1024;
+
+static quint32 readLength(const char *p)
+{
+    return qFromLittleEndian<quint32>(reinterpret_cast<const uchar *>(p));
+}
+
+static void appendLength(QByteArray &out, const quint32 length)
+{
+    uchar bytes[4];
+    qToLittleEndian<quint32>(length, bytes);
+    out.append(reinterpret_cast<const char *>(bytes), 4);
+}
+
+/***********************************************************************
+ * Journal thread lifetime
+ **********************************************************************/
+ChatJournal::ChatJournal(const QString &path, const size_t maxReplay, const size_t maxReplayBytes, const ReplayCallback &replay):
+    _path(path),
+    _maxReplay(maxReplay),
+    _maxReplayBytes(maxReplayBytes),
+    _replay(replay),
+    _done(false)
+{
+    //check the path up front so a bad path is reported to the caller
+    QFile file(_path);
+    if (not file.open(QIODevice::ReadWrite))
+    {
+        throw Pothos::OpenFileException("ChatJournal("+_path.toStdString()+")", file.errorString().toStdString());
+    }
+    file.close();
+    _thread = std::thread(&ChatJournal::run, this);
+}
+
+ChatJournal::~ChatJournal(void)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _done = true;
+    }
+    _cond.notify_one();
+    _thread.join();
+}
+
+void ChatJournal::append(const std::vector<ChatMessage> &messages)
+{
+    if (messages.empty()) return;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (const auto &message : messages)
+        {
+            const auto body = encode(message);
+            appendLength(_pending, quint32(body.size()));
+            _pending.append(body);
+            appendLength(_pending, quint32(body.size()));
+        }
+    }
+    _cond.notify_one();
+}
+
+void ChatJournal::run(void)
+{
+    const size_t validEnd = this->replay();
+
+    QFile file(_path);
+    if (not file.open(QIODevice::ReadWrite)) return;
+    if (size_t(file.size()) > validEnd) file.resize(qint64(validEnd));
+    file.seek(file.size());
+
+    //write whatever accumulated since the last wake-up as one batch
+    QByteArray batch;
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true)
+    {
+        _cond.wait(lock, [this]{return _done or not _pending.isEmpty();});
+        if (_pending.isEmpty()) break;
+        batch.swap(_pending);
+        lock.unlock();
+        file.write(batch);
+        file.flush();
+        batch.clear();
+        lock.lock();
+    }
+}
+
+/***********************************************************************
+ * Replay the tail of the journal
+ **********************************************************************/
+size_t ChatJournal::replay(void)
+{
+    QFile file(_path);
+    if (not file.open(QIODevice::ReadOnly) or file.size() == 0) return 0;
+    const size_t size = size_t(file.size());
+    const auto base = reinterpret_cast<const char *>(file.map(0, file.size()));
+    if (base == nullptr) return size;
+
+    //walk backwards over the trailing lengths, newest record first
+    std::vector<std::pair<size_t, size_t>> records; //body offset, body length
+    auto scanBack = [&](size_t end)
+    {
+        size_t bytes = 0;
+        while (end >= 8 and (_maxReplay == 0 or records.size() < _maxReplay))
+        {
+            const size_t len = readLength(base+end-4);
+            if (len > end-8 or readLength(base+end-8-len) != len) return false;
+            bytes += len;
+            if (_maxReplayBytes != 0 and bytes > _maxReplayBytes and not records.empty()) break;
+            records.emplace_back(end-4-len, len);
+            end -= len+8;
+        }
+        return true;
+    };
+
+    //any mismatched lengths mean the tail is torn, even after records that looked valid,
+    //so find the last complete record from the start and scan back from there
+    size_t validEnd = size;
+    if (not scanBack(size))
+    {
+        records.clear();
+        validEnd = 0;
+        while (validEnd+8 <= size)
+        {
+            const size_t len = readLength(base+validEnd);
+            if (len > size-validEnd-8 or readLength(base+validEnd+4+len) != len) break;
+            validEnd += len+8;
+        }
+        scanBack(validEnd);
+    }
+
+    //decode and hand off the messages oldest first in chunks
+    std::reverse(records.begin(), records.end());
+    std::vector<ChatMessage> chunk;
+    for (const auto &record : records)
+    {
+        ChatMessage message;
+        if (not decode(base+record.first, record.second, message)) continue;
+        chunk.push_back(message);
+        if (chunk.size() < REPLAY_CHUNK_SIZE) continue;
+        if (_replay) _replay(chunk);
+        chunk.clear();
+    }
+    if (not chunk.empty() and _replay) _replay(chunk);
+    return validEnd;
+}
+
+/***********************************************************************
+ * Record encoding
+ **********************************************************************/
+QByteArray ChatJournal::encode(const ChatMessage &message)
+{
+    QByteArray body;
+    QDataStream out(&body, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_5_0);
+    const quint8 flags = (message.isHtml?1:0) | (message.isMonospace?2:0);
+    out << qint64(message.timestamp) << flags
+        << message.username.toUtf8()
+        << message.color.toUtf8()
+        << message.text.toUtf8();
+    return body;
+}
+
+bool ChatJournal::decode(const char *data, const size_t length, ChatMessage &message)
+{
+    const auto body = QByteArray::fromRawData(data, int(length));
+    QDataStream in(body);
+    in.setVersion(QDataStream::Qt_5_0);
+    qint64 timestamp(0);
+    quint8 flags(0);
+    QByteArray username, color, text;
+    in >> timestamp >> flags >> username >> color >> text;
+    if (in.status() != QDataStream::Ok) return false;
+
+    message.timestamp = timestamp;
+    message.isHtml = (flags & 1) != 0;
+    message.isMonospace = (flags & 2) != 0;
+    message.username = QString::fromUtf8(username);
+    message.color = QString::fromUtf8(color);
+    message.text = QString::fromUtf8(text);
+    return true;
+}
+
+/***********************************************************************
+ * Write, reopen, and replay a journal with a torn record at the end
+ **********************************************************************/
+POTHOS_TEST_BLOCK("/widgets/tests", test_chat_journal)
+{
+    QTemporaryDir dir;
+    POTHOS_TEST_TRUE(dir.isValid());
+    const auto path = dir.filePath("chat.journal");
+
+    std::vector<ChatMessage> messages(5);
+    for (size_t i = 0; i < messages.size(); i++)
+    {
+        messages[i].username = "User0";
+        messages[i].color = "blue";
+        messages[i].text = QString("message %1").arg(i);
+        messages[i].timestamp = qint64(i);
+    }
+    {
+        ChatJournal journal(path, 0, 0, ChatJournal::ReplayCallback());
+        journal.append(messages);
+    }
+
+    //simulate a crash in the middle of writing a record
+    {
+        QFile file(path);
+        POTHOS_TEST_TRUE(file.open(QIODevice::Append));
+        file.write("\x40\x00\x00\x00partial", 11);
+    }
+
+    std::vector<ChatMessage> replayed;
+    {
+        ChatJournal journal(path, 3, 0, [&](const std::vector<ChatMessage> &chunk)
+        {
+            replayed.insert(replayed.end(), chunk.begin(), chunk.end());
+        });
+        journal.append(std::vector<ChatMessage>(1, messages.front()));
+    }
+    POTHOS_TEST_EQUAL(replayed.size(), size_t(3));
+    POTHOS_TEST_TRUE(replayed[0].text == "message 2");
+    POTHOS_TEST_TRUE(replayed[2].text == "message 4");
+    POTHOS_TEST_EQUAL(replayed[2].timestamp, qint64(4));
+    POTHOS_TEST_TRUE(replayed[2].username == "User0");
+
+    //the torn record was replaced by the appended message
+    replayed.clear();
+    {
+        ChatJournal journal(path, 0, 0, [&](const std::vector<ChatMessage> &chunk)
+        {
+            replayed.insert(replayed.end(), chunk.begin(), chunk.end());
+        });
+    }
+    POTHOS_TEST_EQUAL(replayed.size(), size_t(6));
+    POTHOS_TEST_TRUE(replayed[5].text == "message 0");
+
+    //a torn record that happens to end like a complete record breaks the chain of lengths
+    {
+        QFile file(path);
+        POTHOS_TEST_TRUE(file.open(QIODevice::Append));
+        static const char torn[] = "\x40\x00\x00\x00" "xx" "\x02\x00\x00\x00" "ab" "\x02\x00\x00\x00";
+        file.write(torn, sizeof(torn)-1);
+    }
+    replayed.clear();
+    {
+        ChatJournal journal(path, 0, 0, [&](const std::vector<ChatMessage> &chunk)
+        {
+            replayed.insert(replayed.end(), chunk.begin(), chunk.end());
+        });
+        journal.append(std::vector<ChatMessage>(1, messages[1]));
+    }
+    POTHOS_TEST_EQUAL(replayed.size(), size_t(6));
+
+    replayed.clear();
+    {
+        ChatJournal journal(path, 0, 0, [&](const std::vector<ChatMessage> &chunk)
+        {
+            replayed.insert(replayed.end(), chunk.begin(), chunk.end());
+        });
+    }
+    POTHOS_TEST_EQUAL(replayed.size(), size_t(7));
+    POTHOS_TEST_TRUE(replayed[6].text == "message 1");
+}
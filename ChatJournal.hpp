@@ -0,0 +1,67 @@
+// Copyright (c) 2026 agent
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include "ChatMessageModel.hpp"
+#include <QByteArray>
+#include <QString>
+#include <condition_variable>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <vector>
+
+/*!
+ * An append-only journal file of chat messages.
+ *
+ * Each record is framed as [length][message][length] with 32-bit little endian lengths,
+ * so the file can be read backwards from the end without an index.
+ * All file access happens on the journal's own thread:
+ * the tail of an existing journal is replayed first by mapping the file
+ * and walking the trailing lengths back to the first record to replay,
+ * then appended messages are written in batches.
+ *
+ * A partially written record at the end of the file (after a crash)
+ * is detected by the mismatched lengths and truncated before appending.
+ */
+class ChatJournal
+{
+public:
+    typedef std::function<void(const std::vector<ChatMessage> &)> ReplayCallback;
+
+    /*!
+     * Open the journal file and start the journal thread.
+     * \param path the journal file path, created when missing
+     * \param maxReplay the maximum number of trailing messages to replay, 0 for all
+     * \param maxReplayBytes the maximum number of record bytes to replay, 0 for all
+     * \param replay called on the journal thread with chunks of replayed messages, oldest first
+     */
+    ChatJournal(const QString &path, const size_t maxReplay, const size_t maxReplayBytes, const ReplayCallback &replay);
+
+    //! Write the remaining messages and stop the journal thread
+    ~ChatJournal(void);
+
+    //! Queue messages to be appended to the journal, safe to call from any thread
+    void append(const std::vector<ChatMessage> &messages);
+
+    //! Encode a message into the record body
+    static QByteArray encode(const ChatMessage &message);
+
+    //! Decode a message from a record body, false when malformed
+    static bool decode(const char *data, const size_t length, ChatMessage &message);
+
+private:
+    void run(void);
+    size_t replay(void);
+
+    const QString _path;
+    const size_t _maxReplay;
+    const size_t _maxReplayBytes;
+    const ReplayCallback _replay;
+
+    std::mutex _mutex;
+    std::condition_variable _cond;
+    QByteArray _pending;
+    bool _done;
+    std::thread _thread;
+};
@@ -0,0 +1,204 @@
+// Copyright (c) 2026 agent
+// SPDX-License-Identifier: BSL-1.0
+
+#include "ChatMessageModel.hpp"
+#include <QTextDocumentFragment>
+#include <QPainter>
+#include <QColor>
+#include <QDateTime>
+#include <QFontDatabase>
+
+/***********************************************************************
+ * Chat message
+ **********************************************************************/
+QString ChatMessage::timePrefix(const qint64 timestamp)
+{
+    if (timestamp == 0) return QString();
+    return QString("[%1] ").arg(QDateTime::fromMSecsSinceEpoch(timestamp).toString("hh:mm:ss"));
+}
+
+QString ChatMessage::toHtml(void) const
+{
+    const auto time = timePrefix(timestamp).toHtmlEscaped();
+    if (isHtml) return time + text;
+    if (isMonospace) return QString("%1<tt>%2</tt>").arg(time).arg(text.toHtmlEscaped().replace(" ", "&nbsp;"));
+    if (username.isEmpty()) return time + text.toHtmlEscaped();
+
+    //the color may come from remote packet metadata, only a valid color name reaches the markup
+    if (not QColor::isValidColor(color)) return QString("%1<b>%2:</b> %3")
+        .arg(time)
+        .arg(username.toHtmlEscaped())
+        .arg(text.toHtmlEscaped());
+    return QString("%1<font color=\"%2\"><b>%3:</b></font> %4")
+        .arg(time)
+        .arg(color.toHtmlEscaped())
+        .arg(username.toHtmlEscaped())
+        .arg(text.toHtmlEscaped());
+}
+
+/***********************************************************************
+ * Chat message model
+ **********************************************************************/
+ChatMessageModel::ChatMessageModel(QObject *parent):
+    QAbstractListModel(parent),
+    _head(0),
+    _bytes(0)
+{
+    return;
+}
+
+int ChatMessageModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid()) return 0;
+    return int(_index.size());
+}
+
+QVariant ChatMessageModel::data(const QModelIndex &index, int role) const
+{
+    if (not index.isValid() or size_t(index.row()) >= _index.size()) return QVariant();
+    const auto &entry = _index[index.row()];
+    const char *user = _arena.data() + entry.offset;
+    const char *text = user + entry.userLen;
+
+    switch (role)
+    {
+    case Qt::DisplayRole:
+        if (entry.userLen == 0) return ChatMessage::timePrefix(entry.timestamp) + QString::fromUtf8(text, entry.textLen);
+        return QString("%1%2: %3")
+            .arg(ChatMessage::timePrefix(entry.timestamp))
+            .arg(QString::fromUtf8(user, entry.userLen))
+            .arg(QString::fromUtf8(text, entry.textLen));
+    case UsernameRole: return QString::fromUtf8(user, entry.userLen);
+    case TextRole: return QString::fromUtf8(text, entry.textLen);
+    case MonospaceRole: return entry.isMonospace;
+    case TimestampRole: return entry.timestamp;
+    case ColorRole:
+        if (not entry.hasColor) return QVariant();
+        return QColor::fromRgb(entry.color);
+    default: return QVariant();
+    }
+}
+
+void ChatMessageModel::append(const std::vector<ChatMessage> &messages)
+{
+    if (messages.empty()) return;
+    const int first = int(_index.size());
+    this->beginInsertRows(QModelIndex(), first, first+int(messages.size())-1);
+    for (const auto &msg : messages)
+    {
+        //legacy rich text is reduced to plain text once on insertion
+        const auto user = msg.username.toUtf8();
+        const auto text = (msg.isHtml? QTextDocumentFragment::fromHtml(msg.text).toPlainText() : msg.text).toUtf8();
+        const QColor color(msg.color);
+
+        Entry entry;
+        entry.offset = _arena.size();
+        entry.timestamp = msg.timestamp;
+        entry.userLen = user.size();
+        entry.textLen = text.size();
+        entry.color = color.rgb();
+        entry.hasColor = color.isValid();
+        entry.isMonospace = msg.isMonospace;
+        _arena.append(user.constData(), size_t(user.size()));
+        _arena.append(text.constData(), size_t(text.size()));
+        _index.push_back(entry);
+        _bytes += this->entryBytes(entry);
+    }
+    this->endInsertRows();
+}
+
+void ChatMessageModel::evict(const size_t maxRows, const size_t maxBytes)
+{
+    //count the oldest rows that exceed the budgets
+    size_t numRows = _index.size();
+    size_t numBytes = _bytes;
+    size_t n = 0;
+    while (numRows-n > 1 and (
+        (maxRows != 0 and numRows-n > maxRows) or
+        (maxBytes != 0 and numBytes > maxBytes)))
+    {
+        numBytes -= this->entryBytes(_index[n]);
+        n++;
+    }
+    if (n == 0) return;
+
+    this->beginRemoveRows(QModelIndex(), 0, int(n)-1);
+    _head = _index[n-1].offset + size_t(_index[n-1].userLen + _index[n-1].textLen);
+    _index.erase(_index.begin(), _index.begin()+n);
+    _bytes = numBytes;
+    this->endRemoveRows();
+
+    //compact the arena once most of it is unused
+    if (_head > 65536 and _head*2 > _arena.size())
+    {
+        _arena.erase(0, _head);
+        for (auto &entry : _index) entry.offset -= _head;
+        _head = 0;
+    }
+}
+
+void ChatMessageModel::clear(void)
+{
+    this->beginResetModel();
+    _arena.clear();
+    _index.clear();
+    _head = 0;
+    _bytes = 0;
+    this->endResetModel();
+}
+
+/***********************************************************************
+ * Chat message delegate
+ **********************************************************************/
+ChatMessageDelegate::ChatMessageDelegate(QObject *parent):
+    QStyledItemDelegate(parent)
+{
+    return;
+}
+
+void ChatMessageDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    painter->save();
+    if (option.state & QStyle::State_Selected) painter->fillRect(option.rect, option.palette.highlight());
+    auto rect = option.rect.adjusted(2, 0, -2, 0);
+
+    const auto time = ChatMessage::timePrefix(index.data(ChatMessageModel::TimestampRole).toLongLong());
+    if (not time.isEmpty())
+    {
+        painter->setFont(option.font);
+        painter->setPen(option.palette.color(QPalette::Disabled, QPalette::Text));
+        painter->drawText(rect, Qt::AlignLeft | Qt::AlignVCenter | Qt::TextSingleLine, time);
+        rect.setLeft(rect.left() + QFontMetrics(option.font).horizontalAdvance(time));
+    }
+
+    const auto user = index.data(ChatMessageModel::UsernameRole).toString();
+    if (not user.isEmpty())
+    {
+        QFont bold(option.font);
+        bold.setBold(true);
+        const auto color = index.data(ChatMessageModel::ColorRole);
+        const auto prefix = user + ": ";
+        painter->setFont(bold);
+        painter->setPen(color.isValid()? color.value<QColor>() : option.palette.color(QPalette::Text));
+        painter->drawText(rect, Qt::AlignLeft | Qt::AlignVCenter | Qt::TextSingleLine, prefix);
+        rect.setLeft(rect.left() + QFontMetrics(bold).horizontalAdvance(prefix));
+    }
+
+    const auto text = index.data(ChatMessageModel::TextRole).toString();
+    QFont font(option.font);
+    if (index.data(ChatMessageModel::MonospaceRole).toBool())
+    {
+        font = QFontDatabase::systemFont(QFontDatabase::FixedFont);
+        font.setPointSizeF(option.font.pointSizeF());
+    }
+    painter->setFont(font);
+    painter->setPen(option.palette.color((option.state & QStyle::State_Selected)? QPalette::HighlightedText : QPalette::Text));
+    painter->drawText(rect, Qt::AlignLeft | Qt::AlignVCenter | Qt::TextSingleLine,
+        QFontMetrics(font).elidedText(text, Qt::ElideRight, rect.width()));
+    painter->restore();
+}
+
+QSize ChatMessageDelegate::sizeHint(const QStyleOptionViewItem &option, const QModelIndex &) const
+{
+    return QSize(option.rect.width(), option.fontMetrics.height() + 2);
+}
@@ -0,0 +1,119 @@
+// Copyright (c) 2026 agent
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include <QAbstractListModel>
+#include <QStyledItemDelegate>
+#include <QString>
+#include <deque>
+#include <string>
+#include <vector>
+
+/*!
+ * A chat message as displayed by the chat box.
+ */
+struct ChatMessage
+{
+    ChatMessage(void):
+        isHtml(false),
+        isMonospace(false),
+        timestamp(0)
+    {
+        return;
+    }
+
+    QString username; //!< the sender, empty for unattributed messages
+    QString color; //!< the display color of the sender
+    QString text; //!< the message text
+    bool isHtml; //!< the text is a legacy rich text fragment
+    bool isMonospace; //!< the text is pre-formatted for a fixed width font
+    qint64 timestamp; //!< the send time in milliseconds since the epoch, 0 when unknown
+
+    //! Render the message as a rich text fragment
+    QString toHtml(void) const;
+
+    //! Format a send time as a "[hh:mm:ss] " prefix, empty when unknown
+    static QString timePrefix(const qint64 timestamp);
+};
+
+/*!
+ * A list model over a compact message store.
+ * The username and text of each message are kept as UTF-8 in one flat arena
+ * with a small index entry per message, and decoded only when a row is drawn.
+ * Old messages are removed from the front of the arena in batches.
+ */
+class ChatMessageModel : public QAbstractListModel
+{
+public:
+    enum Roles
+    {
+        UsernameRole = Qt::UserRole,
+        ColorRole,
+        TextRole,
+        MonospaceRole,
+        TimestampRole,
+    };
+
+    ChatMessageModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const;
+
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const;
+
+    //! Append a batch of messages as new rows at the end
+    void append(const std::vector<ChatMessage> &messages);
+
+    //! Remove the oldest rows until the budgets are met, the newest row is always kept
+    void evict(const size_t maxRows, const size_t maxBytes);
+
+    //! Remove all rows
+    void clear(void);
+
+    //! The number of stored messages
+    size_t size(void) const
+    {
+        return _index.size();
+    }
+
+    //! The approximate memory used by the stored messages
+    size_t bytes(void) const
+    {
+        return _bytes;
+    }
+
+private:
+    struct Entry
+    {
+        size_t offset;
+        qint64 timestamp;
+        int userLen;
+        int textLen;
+        unsigned color; //QRgb
+        bool hasColor;
+        bool isMonospace;
+    };
+
+    size_t entryBytes(const Entry &entry) const
+    {
+        return size_t(entry.userLen + entry.textLen) + sizeof(Entry);
+    }
+
+    std::string _arena;
+    size_t _head;
+    size_t _bytes;
+    std::deque<Entry> _index;
+};
+
+/*!
+ * Draw a message row as the send time, a bold colored username, and the text.
+ * Rows have a uniform single line height so the view only lays out visible rows.
+ */
+class ChatMessageDelegate : public QStyledItemDelegate
+{
+public:
+    ChatMessageDelegate(QObject *parent = nullptr);
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const;
+
+    QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const;
+};
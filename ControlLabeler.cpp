@@ -0,0 +1,38 @@
+// Copyright (c) 2026 agent
+// SPDX-License-Identifier: BSL-1.0
+
+#include "ControlLabeler.hpp"
+
+ControlLabeler::ControlLabeler(const std::string &id):
+    _id(id),
+    _changed(false)
+{
+    return;
+}
+
+void ControlLabeler::setValue(const Pothos::Object &value)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _value = value;
+    _changed = true;
+}
+
+void ControlLabeler::work(Pothos::InputPort *inPort, Pothos::OutputPort *outPort)
+{
+    auto buffer = inPort->buffer();
+    if (buffer.length == 0) return;
+
+    //the label index is relative to the next output element,
+    //so post it before the buffer to mark the first element
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_changed)
+        {
+            outPort->postLabel(Pothos::Label(_id, _value, 0));
+            _changed = false;
+        }
+    }
+
+    inPort->consume(inPort->elements());
+    outPort->postBuffer(std::move(buffer));
+}
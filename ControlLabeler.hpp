@@ -0,0 +1,36 @@
+// Copyright (c) 2026 agent
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include <Pothos/Framework.hpp>
+#include <mutex>
+#include <string>
+
+/*!
+ * Forward a stream from input to output without copying,
+ * and mark control value changes with a label in the stream.
+ *
+ * When the value changes, a label with the new value is attached
+ * to the first element of the next forwarded buffer,
+ * which is the sample where the change takes effect.
+ * Several changes between forwarded buffers are merged into one label with the latest value.
+ * setValue() may be called from any thread.
+ */
+class ControlLabeler
+{
+public:
+    //! Create a labeler that posts labels with the given id
+    ControlLabeler(const std::string &id);
+
+    //! Label the next forwarded buffer with this value
+    void setValue(const Pothos::Object &value);
+
+    //! Forward the available input buffer to the output
+    void work(Pothos::InputPort *inPort, Pothos::OutputPort *outPort);
+
+private:
+    const std::string _id;
+    std::mutex _mutex;
+    Pothos::Object _value;
+    bool _changed;
+};
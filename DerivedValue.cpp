@@ -0,0 +1,105 @@
+// Copyright (c) 2026 agent
+// SPDX-License-Identifier: BSL-1.0
+
+#include "DerivedValue.hpp"
+#include <Pothos/Exception.hpp>
+#include <Pothos/Testing.hpp>
+
+DerivedValue::DerivedValue(void):
+    _mode(VALUE),
+    _alpha(0.2)
+{
+    this->reset();
+}
+
+void DerivedValue::setMode(const std::string &mode)
+{
+    if (mode == "VALUE") _mode = VALUE;
+    else if (mode == "DELTA") _mode = DELTA;
+    else if (mode == "RATE") _mode = RATE;
+    else if (mode == "EWMA") _mode = EWMA;
+    else throw Pothos::InvalidArgumentException("DerivedValue::setMode("+mode+")", "unknown mode");
+    this->reset();
+}
+
+void DerivedValue::setSmoothing(const double alpha)
+{
+    if (alpha <= 0.0 or alpha > 1.0) throw Pothos::RangeException("DerivedValue::setSmoothing()", "smoothing must be in (0.0, 1.0]");
+    _alpha = alpha;
+}
+
+void DerivedValue::reset(void)
+{
+    _primed = false;
+    _lastValue = 0.0;
+    _lastOutput = 0.0;
+    _ewmaPrimed = false;
+}
+
+double DerivedValue::update(const double value)
+{
+    if (_mode == VALUE) return value;
+    return this->update(value, std::chrono::steady_clock::now());
+}
+
+double DerivedValue::update(const double value, const TimePoint &time)
+{
+    if (_mode == VALUE) return value;
+
+    //the first value only starts the interval
+    if (not _primed)
+    {
+        _primed = true;
+        _lastValue = value;
+        _lastTime = time;
+        return _lastOutput;
+    }
+
+    const double delta = value - _lastValue;
+    if (_mode == DELTA)
+    {
+        _lastValue = value;
+        _lastTime = time;
+        return _lastOutput = delta;
+    }
+
+    //extend the interval until time has elapsed rather than divide by zero
+    const double seconds = std::chrono::duration<double>(time - _lastTime).count();
+    if (seconds <= 0.0) return _lastOutput;
+    _lastValue = value;
+    _lastTime = time;
+    const double rate = delta/seconds;
+
+    if (_mode == RATE or not _ewmaPrimed)
+    {
+        _ewmaPrimed = true;
+        return _lastOutput = rate;
+    }
+    return _lastOutput = _alpha*rate + (1.0-_alpha)*_lastOutput;
+}
+
+POTHOS_TEST_BLOCK("/widgets/tests", test_derived_value)
+{
+    const auto t0 = std::chrono::steady_clock::now();
+    const auto sec = [t0](const double s){return t0 + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(s));};
+
+    DerivedValue derived;
+    POTHOS_TEST_EQUAL(derived.update(42.0, sec(0.0)), 42.0);
+
+    derived.setMode("DELTA");
+    POTHOS_TEST_EQUAL(derived.update(100.0, sec(0.0)), 0.0);
+    POTHOS_TEST_EQUAL(derived.update(150.0, sec(1.0)), 50.0);
+    POTHOS_TEST_EQUAL(derived.update(175.0, sec(1.0)), 25.0);
+
+    derived.setMode("RATE");
+    derived.update(0.0, sec(0.0));
+    POTHOS_TEST_CLOSE(derived.update(500.0, sec(0.5)), 1000.0, 1e-6);
+    POTHOS_TEST_CLOSE(derived.update(600.0, sec(0.5)), 1000.0, 1e-6);
+    POTHOS_TEST_CLOSE(derived.update(800.0, sec(1.0)), 600.0, 1e-6);
+
+    derived.setMode("EWMA");
+    derived.setSmoothing(0.5);
+    derived.update(0.0, sec(0.0));
+    POTHOS_TEST_CLOSE(derived.update(100.0, sec(1.0)), 100.0, 1e-6);
+    POTHOS_TEST_CLOSE(derived.update(400.0, sec(2.0)), 200.0, 1e-6);
+}
@@ -0,0 +1,56 @@
+// Copyright (c) 2026 agent
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include <string>
+#include <chrono>
+
+/*!
+ * Derive a displayed value from a stream of counter values.
+ * Each update is timestamped with a steady clock
+ * so that the rate modes need no extra upstream block.
+ */
+class DerivedValue
+{
+public:
+    typedef std::chrono::steady_clock::time_point TimePoint;
+
+    enum Mode
+    {
+        VALUE, //!< pass the value through unchanged
+        DELTA, //!< the difference since the last update
+        RATE, //!< the difference per second since the last update
+        EWMA, //!< the rate smoothed with an exponentially weighted moving average
+    };
+
+    DerivedValue(void);
+
+    //! Set the mode from "VALUE", "DELTA", "RATE", or "EWMA", throws on unknown mode
+    void setMode(const std::string &mode);
+
+    Mode mode(void) const
+    {
+        return _mode;
+    }
+
+    //! Set the EWMA weight given to each new rate (0.0, 1.0]
+    void setSmoothing(const double alpha);
+
+    //! Forget the previous value, the next update starts a new interval
+    void reset(void);
+
+    //! Feed a counter value, returns the derived value
+    double update(const double value);
+
+    //! Feed a counter value at a specific time, returns the derived value
+    double update(const double value, const TimePoint &time);
+
+private:
+    Mode _mode;
+    double _alpha;
+    bool _primed;
+    double _lastValue;
+    TimePoint _lastTime;
+    double _lastOutput;
+    bool _ewmaPrimed;
+};
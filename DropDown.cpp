@@ -3,11 +3,18 @@
 
 #include <Pothos/Framework.hpp>
 #include <Pothos/Object/Containers.hpp>
+#include "ControlLabeler.hpp"
+#include "OptionModel.hpp"
+#include "OptionFile.hpp"
+#include "OptionSearch.hpp"
 #include <QComboBox>
+#include <QLineEdit>
+#include <QListView>
 #include <QLabel>
 #include <QHBoxLayout>
 #include <QEvent>
 #include <vector>
+#include <mutex>
 
 /***********************************************************************
  * |PothosDoc Drop Down
@@ -18,6 +25,15 @@
  * |category /Widgets
  * |keywords dropdown combobox
  *
+ * |param portMode [Port Mode] Enable an optional stream passthrough.
+ * The passthrough forwards an input stream to the output without copying,
+ * and each selection change is marked by a "valueChanged" label carrying the new value,
+ * at the first sample of the next forwarded buffer.
+ * |default "NONE"
+ * |option [None] "NONE"
+ * |option [Stream Passthrough] "PASSTHROUGH"
+ * |preview disable
+ *
  * |param title The name of the value displayed by this widget
  * |default "My Menu Value"
  * |widget StringEntry()
@@ -32,10 +48,32 @@
  *
  * |default [["Opt0", 42], ["Opt1", "xyz"]]
  *
+ * |param optionsFile [Options File] Load the options from a local file instead of the options list.
+ * A CSV file has one title,value record per line, double quote fields that contain commas.
+ * A JSON lines file (.jsonl) has one ["title", value] array per line.
+ * Unquoted numbers and true/false are loaded as values of that type, everything else as strings.
+ * The file is checked again when the design is activated, and only reloaded when it changed.
+ * Leave empty to use the options list.
+ * |default ""
+ * |widget FileEntry(mode=open)
+ * |preview valid
+ *
+ * |param filter [Filter] Show a search box to filter the options by title.
+ * Typing in the search box limits the menu to the options with a title
+ * that contains the search text, ignoring case.
+ * The search index is built once when the filter is first used after the options are set,
+ * so filtering stays fast for very long option lists, and costs nothing while hidden.
+ * |default false
+ * |option [Hidden] false
+ * |option [Shown] true
+ * |preview disable
+ *
  * |mode graphWidget
- * |factory /widgets/drop_down()
+ * |factory /widgets/drop_down(portMode)
  * |setter setTitle(title)
+ * |setter setFilter(filter)
  * |setter setOptions(options)
+ * |setter setOptionsFile(optionsFile)
  * |setter setValue(value)
  **********************************************************************/
 class DropDown : public QWidget, public Pothos::Block
@@ -43,20 +81,31 @@ class DropDown : public QWidget, public Pothos::Block
     Q_OBJECT
 public:
 
-    static Block *make(void)
+    static Block *make(const std::string &portMode)
     {
-        return new DropDown();
+        return new DropDown(portMode);
     }
 
-    DropDown(void):
+    DropDown(const std::string &portMode):
         _label(new QLabel(this)),
-        _comboBox(new QComboBox(this))
+        _comboBox(new QComboBox(this)),
+        _optionModel(new OptionListModel(this)),
+        _filterEdit(new QLineEdit(this)),
+        _filterModel(new OptionFilterModel(this)),
+        _listOptions(std::make_shared<OptionSet>()),
+        _filtering(false),
+        _selectedRow(-1),
+        _labeler("valueChanged")
     {
         auto hlayout = new QHBoxLayout(this);
         hlayout->setContentsMargins(QMargins());
         hlayout->setSpacing(1);
         hlayout->addWidget(_label);
+        hlayout->addWidget(_filterEdit);
         hlayout->addWidget(_comboBox);
+        _filterEdit->setPlaceholderText(tr("Search..."));
+        _filterEdit->setClearButtonEnabled(true);
+        _filterEdit->hide();
 
         this->registerCall(this, POTHOS_FCN_TUPLE(DropDown, widget));
         this->registerCall(this, POTHOS_FCN_TUPLE(DropDown, value));
@@ -64,12 +113,22 @@ public:
         this->registerCall(this, POTHOS_FCN_TUPLE(DropDown, setTitle));
         this->registerCall(this, POTHOS_FCN_TUPLE(DropDown, setValue));
         this->registerCall(this, POTHOS_FCN_TUPLE(DropDown, setOptions));
+        this->registerCall(this, POTHOS_FCN_TUPLE(DropDown, setOptionsFile));
+        this->registerCall(this, POTHOS_FCN_TUPLE(DropDown, setFilter));
         this->registerSignal("valueChanged");
         this->registerSignal("labelChanged");
 
         qRegisterMetaType<Pothos::Object>("Pothos::Object");
-        qRegisterMetaType<Pothos::ObjectVector>("Pothos::ObjectVector");
-        connect(_comboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &DropDown::handleIndexChanged);
+        qRegisterMetaType<OptionSetPtr>("OptionSetPtr");
+        this->setupComboBox();
+        connect(_filterEdit, &QLineEdit::textChanged, this, &DropDown::handleFilterChanged);
+
+        if (portMode == "PASSTHROUGH")
+        {
+            this->setupInput(0);
+            this->setupOutput(0);
+        }
+        else if (portMode != "NONE") throw Pothos::InvalidArgumentException("DropDown("+portMode+")", "unknown port mode");
     }
 
     /*!
@@ -82,13 +141,11 @@ public:
     {
         if (e->type() == QEvent::ParentAboutToChange)
         {
-            const auto oldIndex = _comboBox->currentIndex();
-            QStringList oldItems; for (int i = 0; i < _comboBox->count(); i++) oldItems.push_back(_comboBox->itemText(i));
+            _comboBox->blockSignals(true);
             delete _comboBox;
             _comboBox = (new QComboBox(this));
             layout()->addWidget(_comboBox);
-            _comboBox->addItems(oldItems);
-            _comboBox->setCurrentIndex(oldIndex);
+            this->setupComboBox();
         }
         return QWidget::event(e);
     }
@@ -100,17 +157,25 @@ public:
 
     void activate(void)
     {
+        //pick up changes to the options file since it was last loaded
+        this->loadOptionsFile();
+
         //emit current value when design becomes active
         this->emitSignal("labelChanged", this->label());
         this->emitSignal("valueChanged", this->value());
+        _labeler.setValue(this->value());
+    }
+
+    void work(void)
+    {
+        if (this->inputs().empty()) return;
+        _labeler.work(this->input(0), this->output(0));
     }
 
     Pothos::Object value(void) const
     {
-        const auto index = _comboBox->currentIndex();
-        if (index < 0) return Pothos::Object();
-        if (size_t(index) >= _optionValues.size()) return Pothos::Object();
-        return _optionValues.at(index);
+        std::lock_guard<std::mutex> lock(_selectionMutex);
+        return _selectedValue;
     }
 
     void setValue(const Pothos::Object &value)
@@ -120,20 +185,29 @@ public:
 
     QString label(void) const
     {
-        return _comboBox->currentText();
+        std::lock_guard<std::mutex> lock(_selectionMutex);
+        return _selectedLabel;
     }
 
     void setOptions(const Pothos::ObjectVector &options)
     {
-        //validate first
-        for (const auto &option : options)
-        {
-            if (not option.canConvert(typeid(Pothos::ObjectVector))) throw Pothos::DataFormatException("DropDown::setOptions()", "entry is not ObjectVector");
-            auto optPair = option.convert<Pothos::ObjectVector>();
-            if (optPair.size() != 2) throw Pothos::DataFormatException("DropDown::setOptions()", "entry must be ObjectVector of size == 2");
-            if (not optPair.at(0).canConvert(typeid(QString))) throw Pothos::DataFormatException("DropDown::setOptions()", "entry[0] must be a string");
-        }
-        QMetaObject::invokeMethod(this, "__setOptions", Qt::QueuedConnection, Q_ARG(Pothos::ObjectVector, options));
+        //validate and convert once, the GUI thread shares the immutable result
+        _listOptions = OptionSet::make(options, "DropDown::setOptions()");
+        if (_optionsPath.isEmpty()) this->postOptions(_listOptions);
+    }
+
+    void setOptionsFile(const QString &path)
+    {
+        //the options file takes the place of the options list until it is cleared
+        const bool hadFile = not _optionsPath.isEmpty();
+        _optionsPath = path;
+        this->loadOptionsFile();
+        if (hadFile and path.isEmpty()) this->postOptions(_listOptions);
+    }
+
+    void setFilter(const bool enable)
+    {
+        QMetaObject::invokeMethod(this, "__setFilter", Qt::QueuedConnection, Q_ARG(bool, enable));
     }
 
     void setTitle(const QString &title)
@@ -147,52 +221,191 @@ public slots:
 
     QVariant saveState(void) const
     {
-        return _comboBox->currentIndex();
+        return _selectedRow;
     }
 
     void restoreState(const QVariant &state)
     {
-        _comboBox->setCurrentIndex(state.toInt());
+        this->selectRow(state.toInt());
     }
 
 private slots:
 
-    void __setOptions(const Pothos::ObjectVector &options)
+    void __setOptions(const OptionSetPtr &options)
     {
         auto oldValue = this->value();
-        _comboBox->clear();
-        _optionValues.clear();
-
-        for (const auto &option : options)
+        _searchIndex.reset(); //rebuilt on demand by the filter
+        _optionModel->setOptions(options);
+        if (_filtering)
         {
-            auto optPair = option.convert<Pothos::ObjectVector>();
-            auto title = optPair.at(0).convert<QString>();
-            auto value = optPair.at(1);
-            _comboBox->addItem(title);
-            _optionValues.push_back(value);
+            //refilter the new options without selecting a row in between
+            const bool oldState = _comboBox->blockSignals(true);
+            this->applyFilter();
+            _selectedRow = options->indexOf(oldValue);
+            _comboBox->setCurrentIndex(this->rowToComboIndex(_selectedRow));
+            _comboBox->blockSignals(oldState);
         }
+        else _selectedRow = _comboBox->currentIndex();
+        this->__setValue(oldValue);
 
-        this->setValue(oldValue);
+        //rows are updated in place, so the selected row can keep its index
+        //but stand for a different option without a combo box index change
+        const auto publishedValue = this->value();
+        const auto publishedLabel = this->label();
+        this->storeSelection();
+        if (not sameValue(this->value(), publishedValue) or this->label() != publishedLabel) this->emitSelection();
     }
 
     void __setValue(const Pothos::Object &value)
     {
-        for (int i = 0; i < _comboBox->count(); i++)
+        const int row = _optionModel->options()->indexOf(value);
+        if (row >= 0) this->selectRow(row);
+    }
+
+    void __setFilter(const bool enable)
+    {
+        _filterEdit->setVisible(enable);
+        if (not enable) _filterEdit->clear();
+        if (enable == _filtering) return;
+
+        //switch the combo box between the full and filtered models, keeping the selection
+        _filtering = enable;
+        const bool oldState = _comboBox->blockSignals(true);
+        if (_filtering) this->applyFilter();
+        _comboBox->setModel(_filtering?static_cast<QAbstractItemModel *>(_filterModel):_optionModel);
+        _comboBox->setCurrentIndex(this->rowToComboIndex(_selectedRow));
+        _comboBox->blockSignals(oldState);
+    }
+
+    void handleFilterChanged(const QString &)
+    {
+        if (not _filtering) return;
+        const bool oldState = _comboBox->blockSignals(true);
+        this->applyFilter();
+        _comboBox->setCurrentIndex(this->rowToComboIndex(_selectedRow));
+        _comboBox->blockSignals(oldState);
+    }
+
+    void handleIndexChanged(const int index)
+    {
+        //a filtered out selection is not a new selection
+        const int row = this->comboIndexToRow(index);
+        if (row < 0 and _filtering) return;
+        _selectedRow = row;
+        this->storeSelection();
+        this->emitSelection();
+    }
+
+private:
+
+    static bool sameValue(const Pothos::Object &a, const Pothos::Object &b)
+    {
+        if (not a or not b) return bool(a) == bool(b);
+        return a.equals(b);
+    }
+
+    //publish the option of the selected row for the getters
+    void storeSelection(void)
+    {
+        Pothos::Object value;
+        QString title;
+        const auto &options = _optionModel->options();
+        if (_selectedRow >= 0 and size_t(_selectedRow) < options->size())
         {
-            if (_optionValues.at(i).equals(value)) _comboBox->setCurrentIndex(i);
+            value = options->value(_selectedRow);
+            title = options->title(_selectedRow);
         }
+        std::lock_guard<std::mutex> lock(_selectionMutex);
+        _selectedValue = value;
+        _selectedLabel = title;
     }
 
-    void handleIndexChanged(const int)
+    void emitSelection(void)
     {
+        _labeler.setValue(this->value());
         this->emitSignal("valueChanged", this->value());
         this->emitSignal("labelChanged", this->label());
     }
 
-private:
+    void postOptions(const OptionSetPtr &optionSet)
+    {
+        QMetaObject::invokeMethod(this, "__setOptions", Qt::QueuedConnection, Q_ARG(OptionSetPtr, optionSet));
+    }
+
+    void loadOptionsFile(void)
+    {
+        const auto optionSet = _optionFile.load(_optionsPath, "DropDown::setOptionsFile()");
+        if (optionSet) this->postOptions(optionSet);
+    }
+
+    void setupComboBox(void)
+    {
+        _comboBox->setModel(_filtering?static_cast<QAbstractItemModel *>(_filterModel):_optionModel);
+        _comboBox->setCurrentIndex(this->rowToComboIndex(_selectedRow));
+
+        //uniform rows keep the popup fast when the model is reset with many options
+        auto view = new QListView(_comboBox);
+        view->setUniformItemSizes(true);
+        _comboBox->setView(view);
+        connect(_comboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &DropDown::handleIndexChanged);
+    }
+
+    void applyFilter(void)
+    {
+        //the index is only built once a query is typed, an empty query shows every row
+        const auto &options = _optionModel->options();
+        std::vector<int> rows;
+        if (_filterEdit->text().isEmpty())
+        {
+            rows.resize(options->size());
+            for (size_t row = 0; row < rows.size(); row++) rows[row] = int(row);
+        }
+        else
+        {
+            if (not _searchIndex) _searchIndex = std::make_shared<const OptionSearchIndex>(*options);
+            rows = _searchIndex->find(_filterEdit->text());
+        }
+        _filterModel->setRows(options, std::move(rows));
+    }
+
+    void selectRow(const int row)
+    {
+        //a filtered out row is selected by clearing the filter
+        if (_filtering and _filterModel->indexOfRow(row) < 0 and not _filterEdit->text().isEmpty())
+        {
+            _filterEdit->clear();
+        }
+        _comboBox->setCurrentIndex(this->rowToComboIndex(row));
+    }
+
+    int comboIndexToRow(const int index) const
+    {
+        return _filtering?_filterModel->sourceRow(index):index;
+    }
+
+    int rowToComboIndex(const int row) const
+    {
+        if (row < 0) return -1;
+        return _filtering?_filterModel->indexOfRow(row):row;
+    }
+
     QLabel *_label;
     QComboBox *_comboBox;
-    std::vector<Pothos::Object> _optionValues;
+    OptionListModel *_optionModel;
+    QLineEdit *_filterEdit;
+    OptionFilterModel *_filterModel;
+    OptionSearchIndexPtr _searchIndex;
+    OptionSetPtr _listOptions;
+    QString _optionsPath;
+    OptionFile _optionFile;
+    bool _filtering;
+    int _selectedRow;
+    ControlLabeler _labeler;
+
+    //the published selection for the getters
+    mutable std::mutex _selectionMutex;
+    Pothos::Object _selectedValue;
+    QString _selectedLabel;
 };
 
 static Pothos::BlockRegistry registerDropDown(
@@ -0,0 +1,106 @@
+// Copyright (c) 2026 agent
+// SPDX-License-Identifier: BSL-1.0
+
+#include "EmitThrottle.hpp"
+#include <Pothos/Exception.hpp>
+#include <Pothos/Testing.hpp>
+
+EmitThrottle::EmitThrottle(void):
+    _minPeriod(Duration::zero()),
+    _primed(false),
+    _pending(false)
+{
+    return;
+}
+
+void EmitThrottle::setMaxRate(const double rate)
+{
+    if (rate < 0.0) throw Pothos::RangeException("EmitThrottle::setMaxRate()", "rate must be non-negative");
+    _minPeriod = (rate == 0.0)? Duration::zero() :
+        std::chrono::duration_cast<Duration>(std::chrono::duration<double>(1.0/rate));
+}
+
+bool EmitThrottle::update(void)
+{
+    return this->update(std::chrono::steady_clock::now());
+}
+
+bool EmitThrottle::update(const TimePoint &time)
+{
+    //emit now when outside of the rate limit, otherwise coalesce into one later emit
+    if (not _primed or time - _lastEmit >= _minPeriod)
+    {
+        _primed = true;
+        _pending = false;
+        _lastEmit = time;
+        return true;
+    }
+    _pending = true;
+    return false;
+}
+
+bool EmitThrottle::flush(void)
+{
+    return this->flush(std::chrono::steady_clock::now());
+}
+
+bool EmitThrottle::flush(const TimePoint &time)
+{
+    if (not _pending) return false;
+    _pending = false;
+    _lastEmit = time;
+    return true;
+}
+
+EmitThrottle::Duration EmitThrottle::delay(const TimePoint &time) const
+{
+    const auto elapsed = time - _lastEmit;
+    return (elapsed >= _minPeriod)? Duration::zero() : _minPeriod - elapsed;
+}
+
+int EmitThrottle::delayMs(void) const
+{
+    const auto wait = this->delay(std::chrono::steady_clock::now());
+    const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(wait);
+    return int(ms.count()) + ((ms < wait)? 1 : 0);
+}
+
+POTHOS_TEST_BLOCK("/widgets/tests", test_emit_throttle)
+{
+    const auto t0 = std::chrono::steady_clock::now();
+    const auto ms = [t0](const int n){return t0 + std::chrono::milliseconds(n);};
+
+    //no limit, every change is emitted
+    EmitThrottle unlimited;
+    for (int t = 0; t < 10; t++) POTHOS_TEST_TRUE(unlimited.update(ms(0)));
+    POTHOS_TEST_TRUE(not unlimited.pending());
+
+    //a change every millisecond for one second under a 10 per second limit,
+    //the pending value is flushed when the owner's timer would expire
+    EmitThrottle throttle;
+    throttle.setMaxRate(10.0);
+    size_t numEmits = 0;
+    bool timerActive = false;
+    EmitThrottle::TimePoint timerExpiry;
+    for (int t = 0; t < 1000; t++)
+    {
+        if (timerActive and ms(t) >= timerExpiry)
+        {
+            timerActive = false;
+            if (throttle.flush(ms(t))) numEmits++;
+        }
+        if (throttle.update(ms(t))) numEmits++;
+        else if (not timerActive)
+        {
+            timerActive = true;
+            timerExpiry = ms(t) + throttle.delay(ms(t));
+        }
+    }
+    POTHOS_TEST_EQUAL(numEmits, size_t(10));
+
+    //the last value is emitted when the drag is released
+    POTHOS_TEST_TRUE(throttle.pending());
+    POTHOS_TEST_TRUE(throttle.flush(ms(999)));
+    POTHOS_TEST_TRUE(not throttle.flush(ms(999)));
+    POTHOS_TEST_TRUE(not throttle.pending());
+}
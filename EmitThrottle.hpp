@@ -0,0 +1,53 @@
+// Copyright (c) 2026 agent
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include <chrono>
+
+/*!
+ * Decide when a rapidly changing value is emitted under a maximum rate.
+ * A change inside the minimum period becomes pending rather than emitted,
+ * and the owner emits it with flush() once delay() has passed or the change ends.
+ * The time may be passed in so that the decisions can be tested without a clock.
+ */
+class EmitThrottle
+{
+public:
+    typedef std::chrono::steady_clock::time_point TimePoint;
+    typedef std::chrono::steady_clock::duration Duration;
+
+    EmitThrottle(void);
+
+    //! Set the maximum number of emits per second, 0 for no limit
+    void setMaxRate(const double rate);
+
+    //! A new value arrived, returns true when it should be emitted now
+    bool update(void);
+
+    //! A new value arrived at a specific time, returns true when it should be emitted now
+    bool update(const TimePoint &time);
+
+    //! Returns true when a value is pending and should be emitted now
+    bool flush(void);
+
+    //! Returns true when a value is pending and should be emitted at a specific time
+    bool flush(const TimePoint &time);
+
+    //! Is a value waiting to be emitted?
+    bool pending(void) const
+    {
+        return _pending;
+    }
+
+    //! The wait from a specific time until the pending value may be emitted
+    Duration delay(const TimePoint &time) const;
+
+    //! The wait in whole milliseconds, rounded up, from now
+    int delayMs(void) const;
+
+private:
+    Duration _minPeriod;
+    bool _primed;
+    bool _pending;
+    TimePoint _lastEmit;
+};
@@ -0,0 +1,222 @@
+// Copyright (c) 2026 agent
+// SPDX-License-Identifier: BSL-1.0
+
+#include "FormatEngine.hpp"
+#include <Pothos/Testing.hpp>
+#include <QElapsedTimer>
+#include <algorithm> //min/max
+#include <iostream>
+#include <cstdio> //snprintf
+
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#include <charconv>
+#endif
+
+FormatEngine::FormatEngine(void):
+    _literalLength(0),
+    _notation(GENERAL),
+    _precision(6),
+    _base(10)
+{
+    this->setFormat("%1");
+}
+
+void FormatEngine::setFormat(const QString &formatStr)
+{
+    _segments.clear();
+    _literalLength = 0;
+
+    QString literal;
+    const int n = formatStr.size();
+    for (int i = 0; i < n; i++)
+    {
+        //parse a %N or %NN place marker
+        if (formatStr[i] == '%' and i+1 < n and formatStr[i+1].isDigit())
+        {
+            int arg = formatStr[i+1].digitValue();
+            int len = 2;
+            if (i+2 < n and formatStr[i+2].isDigit())
+            {
+                arg = arg*10 + formatStr[i+2].digitValue();
+                len = 3;
+            }
+            if (arg != 0)
+            {
+                if (not literal.isEmpty()) _segments.push_back(Segment{literal, 0});
+                _literalLength += literal.size();
+                literal.clear();
+                _segments.push_back(Segment{formatStr.mid(i, len), arg});
+                i += len-1;
+                continue;
+            }
+        }
+        literal += formatStr[i];
+    }
+    if (not literal.isEmpty()) _segments.push_back(Segment{literal, 0});
+    _literalLength += literal.size();
+}
+
+void FormatEngine::setNotation(const Notation notation)
+{
+    _notation = notation;
+}
+
+void FormatEngine::setPrecision(const int precision)
+{
+    _precision = std::min(std::max(precision, -1), 100);
+}
+
+void FormatEngine::setBase(const int base)
+{
+    _base = std::min(std::max(base, 2), 36);
+}
+
+QString FormatEngine::format(const QString &value) const
+{
+    QString out;
+    out.reserve(_literalLength + value.size());
+    for (const auto &seg : _segments)
+    {
+        if (seg.arg == 1) out += value;
+        else out += seg.literal;
+    }
+    return out;
+}
+
+QString FormatEngine::format(const double value) const
+{
+    char num[NUM_BUFF_SIZE];
+    return this->substitute(num, this->writeDouble(num, value));
+}
+
+QString FormatEngine::format(const long long value) const
+{
+    char num[NUM_BUFF_SIZE];
+    return this->substitute(num, this->writeInteger(num, value));
+}
+
+QString FormatEngine::format(const std::complex<double> &value) const
+{
+    QString out = this->format(value.real());
+    out += '+';
+    out += this->format(value.imag());
+    out += 'j';
+    return out;
+}
+
+QString FormatEngine::format(const std::vector<double> &values) const
+{
+    QString out;
+    out.reserve(_literalLength + int(values.size())*8);
+    char num[NUM_BUFF_SIZE];
+    for (const auto &seg : _segments)
+    {
+        if (seg.arg == 0 or size_t(seg.arg) > values.size()) out += seg.literal;
+        else out += QLatin1String(num, int(this->writeDouble(num, values[seg.arg-1])));
+    }
+    return out;
+}
+
+QString FormatEngine::substitute(const char *num, const size_t len) const
+{
+    QString out;
+    out.reserve(_literalLength + int(len));
+    for (const auto &seg : _segments)
+    {
+        if (seg.arg == 1) out += QLatin1String(num, int(len));
+        else out += seg.literal;
+    }
+    return out;
+}
+
+size_t FormatEngine::writeDouble(char *out, const double value) const
+{
+#ifdef __cpp_lib_to_chars
+    std::chars_format fmt = std::chars_format::general;
+    if (_notation == FIXED) fmt = std::chars_format::fixed;
+    if (_notation == SCIENTIFIC) fmt = std::chars_format::scientific;
+    const auto r = (_precision < 0)?
+        std::to_chars(out, out+NUM_BUFF_SIZE, value, fmt):
+        std::to_chars(out, out+NUM_BUFF_SIZE, value, fmt, _precision);
+    if (r.ec == std::errc()) return size_t(r.ptr - out);
+#endif
+    const char *spec = "%.*g";
+    if (_notation == FIXED) spec = "%.*f";
+    if (_notation == SCIENTIFIC) spec = "%.*e";
+    const int len = std::snprintf(out, NUM_BUFF_SIZE, spec, (_precision < 0)?17:_precision, value);
+    return size_t(std::min(std::max(len, 0), int(NUM_BUFF_SIZE-1)));
+}
+
+size_t FormatEngine::writeInteger(char *out, const long long value) const
+{
+    static const char digits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+    //write digits in reverse from the magnitude, then flip in place
+    unsigned long long mag = (value < 0)? 0ull-(unsigned long long)(value) : (unsigned long long)(value);
+    size_t len = 0;
+    do
+    {
+        out[len++] = digits[mag % _base];
+        mag /= _base;
+    } while (mag != 0);
+    if (value < 0) out[len++] = '-';
+    std::reverse(out, out+len);
+    return len;
+}
+
+/***********************************************************************
+ * Compare the format engine against QString::arg()
+ **********************************************************************/
+POTHOS_TEST_BLOCK("/widgets/tests", test_format_engine)
+{
+    FormatEngine engine;
+    POTHOS_TEST_TRUE(engine.format(1.5) == QString("%1").arg(1.5));
+    POTHOS_TEST_TRUE(engine.format(0.1234567) == QString("%1").arg(0.1234567));
+    POTHOS_TEST_TRUE(engine.format(1e6) == QString("%1").arg(1e6));
+    POTHOS_TEST_TRUE(engine.format(-42ll) == QString("%1").arg(-42));
+
+    engine.setFormat("x=%1 units %2 %1");
+    POTHOS_TEST_TRUE(engine.format(2.25) == QString("x=%1 units %2 %1").arg(2.25));
+    POTHOS_TEST_TRUE(engine.format(QString("abc")) == QString("x=%1 units %2 %1").arg("abc"));
+
+    engine.setBase(16);
+    POTHOS_TEST_TRUE(engine.format(255ll) == QString("x=%1 units %2 %1").arg(255, 0, 16));
+    POTHOS_TEST_TRUE(engine.format(-255ll) == QString("x=%1 units %2 %1").arg(-255, 0, 16));
+
+    engine.setFormat("[%1, %2]");
+    POTHOS_TEST_TRUE(engine.format(std::vector<double>{1.0, 2.5}) == QString("[1, 2.5]"));
+    POTHOS_TEST_TRUE(engine.format(std::vector<double>{1.0}) == QString("[1, %2]"));
+
+    engine.setFormat("%1");
+    engine.setNotation(FormatEngine::FIXED);
+    engine.setPrecision(3);
+    POTHOS_TEST_TRUE(engine.format(3.14159) == QString("3.142"));
+    engine.setNotation(FormatEngine::SCIENTIFIC);
+    engine.setPrecision(2);
+    POTHOS_TEST_TRUE(engine.format(31415.9) == QString("3.14e+04"));
+    POTHOS_TEST_TRUE(engine.format(std::complex<double>(1.0, 2.0)) == QString("1.00e+00+2.00e+00j"));
+}
+
+POTHOS_TEST_BLOCK("/widgets/tests", test_format_engine_benchmark)
+{
+    static const int numIters = 100000;
+    const QString formatStr("Power: %1 dBm");
+    FormatEngine engine;
+    engine.setFormat(formatStr);
+
+    //keep the results live so the loops are not optimized out
+    int total0 = 0, total1 = 0;
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < numIters; i++) total0 += formatStr.arg(i*0.123).size();
+    const auto argNs = timer.nsecsElapsed();
+
+    timer.restart();
+    for (int i = 0; i < numIters; i++) total1 += engine.format(i*0.123).size();
+    const auto engineNs = timer.nsecsElapsed();
+
+    std::cout << "QString::arg(): " << (argNs/numIters) << " ns/value" << std::endl;
+    std::cout << "FormatEngine::format(): " << (engineNs/numIters) << " ns/value" << std::endl;
+    POTHOS_TEST_EQUAL(total0, total1);
+}
@@ -0,0 +1,68 @@
+// Copyright (c) 2026 agent
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include <QString>
+#include <complex>
+#include <vector>
+
+/*!
+ * The format engine compiles a format string with %1 through %99 place markers
+ * into literal and placeholder segments when the format string is set.
+ * Formatting a value writes the number into a stack buffer
+ * and appends the segments without re-scanning the format string.
+ *
+ * The single value format() calls substitute the value into every %1 marker,
+ * and leave the other place markers untouched like QString::arg().
+ */
+class FormatEngine
+{
+public:
+    enum Notation
+    {
+        GENERAL, //!< like printf %g
+        FIXED, //!< like printf %f
+        SCIENTIFIC, //!< like printf %e
+    };
+
+    FormatEngine(void);
+
+    //! Compile the format string into segments
+    void setFormat(const QString &formatStr);
+
+    //! Set the floating point notation
+    void setNotation(const Notation notation);
+
+    //! Set the floating point precision, -1 for the shortest round-trip representation
+    void setPrecision(const int precision);
+
+    //! Set the integer base (2 through 36)
+    void setBase(const int base);
+
+    QString format(const QString &value) const;
+    QString format(const double value) const;
+    QString format(const long long value) const;
+
+    //! Format as real+imagj where each part is substituted into the format string
+    QString format(const std::complex<double> &value) const;
+
+    //! Substitute values[i] into the %(i+1) place marker
+    QString format(const std::vector<double> &values) const;
+
+private:
+    static const size_t NUM_BUFF_SIZE = 512;
+    size_t writeDouble(char *out, const double value) const;
+    size_t writeInteger(char *out, const long long value) const;
+    QString substitute(const char *num, const size_t len) const;
+
+    struct Segment
+    {
+        QString literal; //!< literal text when arg is 0, otherwise the original place marker
+        int arg; //!< the place marker number or 0 for literal text
+    };
+    std::vector<Segment> _segments;
+    int _literalLength;
+    Notation _notation;
+    int _precision;
+    int _base;
+};
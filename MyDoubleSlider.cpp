@@ -2,15 +2,24 @@
 // SPDX-License-Identifier: BSL-1.0
 
 #include "MyDoubleSlider.hpp"
-#include <cmath> //lround
+#include <QTimer>
+#include <cmath> //lround, ceil
 
 MyDoubleSlider::MyDoubleSlider(const Qt::Orientation orientation, QWidget *parent):
     QSlider(orientation, parent),
     _minimum(0.0),
     _maximum(100.0),
-    _stepSize(1.0)
+    _stepSize(1.0),
+    _trackingMode("CONTINUOUS"),
+    _maxRate(0.0),
+    _settleTime(0),
+    _emitTimer(new QTimer(this)),
+    _pending(false)
 {
+    _emitTimer->setSingleShot(true);
+    connect(_emitTimer, &QTimer::timeout, this, &MyDoubleSlider::emitPending);
     connect(this, &QSlider::valueChanged, this, &MyDoubleSlider::handleIntValueChanged);
+    connect(this, &QSlider::sliderReleased, this, &MyDoubleSlider::handleSliderReleased);
 }
 
 double MyDoubleSlider::value(void) const
@@ -50,8 +59,59 @@ void MyDoubleSlider::setSingleStep(const double val)
     this->updateRange(oldValue);
 }
 
+void MyDoubleSlider::setTrackingMode(const QString &mode)
+{
+    _trackingMode = mode;
+    this->emitPending();
+}
+
+void MyDoubleSlider::setMaxRate(const double rate)
+{
+    _maxRate = rate;
+}
+
+void MyDoubleSlider::setSettleTime(const int ms)
+{
+    _settleTime = ms;
+}
+
 void MyDoubleSlider::handleIntValueChanged(const int)
 {
+    _pending = true;
+
+    if (_trackingMode == "RELEASE")
+    {
+        if (not this->isSliderDown()) this->emitPending();
+        return;
+    }
+
+    if (_trackingMode == "SETTLE")
+    {
+        _emitTimer->start(_settleTime);
+        return;
+    }
+
+    //continuous: emit now unless the last emission was too recent,
+    //otherwise the timer emits the latest value when the period expires
+    if (_emitTimer->isActive()) return;
+    const qint64 periodMs = (_maxRate > 0.0)? qint64(std::ceil(1000.0/_maxRate)) : 0;
+    const qint64 elapsedMs = _lastEmit.isValid()? _lastEmit.elapsed() : periodMs;
+    if (elapsedMs >= periodMs) this->emitPending();
+    else _emitTimer->start(int(periodMs - elapsedMs));
+}
+
+void MyDoubleSlider::handleSliderReleased(void)
+{
+    //the final value of a drag is not held back by the rate limit
+    if (_trackingMode != "SETTLE") this->emitPending();
+}
+
+void MyDoubleSlider::emitPending(void)
+{
+    _emitTimer->stop();
+    if (not _pending) return;
+    _pending = false;
+    _lastEmit.start();
     emit this->valueChanged(this->value());
 }
 
@@ -2,7 +2,23 @@
 // SPDX-License-Identifier: BSL-1.0
 
 #include <QSlider>
+#include <QElapsedTimer>
 
+class QTimer;
+
+/*!
+ * A slider over a double range.
+ *
+ * The tracking mode controls how often valueChanged() is emitted while the user drags:
+ * "CONTINUOUS" emits on every step, limited to at most max rate emissions per second,
+ * "RELEASE" emits once when the slider is released,
+ * and "SETTLE" emits once the value has not changed for the settle time.
+ * Changes that are not made by dragging the handle are emitted according to the same mode,
+ * except that release mode emits them immediately.
+ * The final value of a drag is always emitted exactly once.
+ * The emission timer belongs to the GUI thread, so the slots must be called
+ * from the GUI thread or through a queued connection.
+ */
 class MyDoubleSlider : public QSlider
 {
     Q_OBJECT
@@ -20,8 +36,19 @@ public slots:
     void setMaximum(const double max);
     void setSingleStep(const double val);
 
+    //! Set the tracking mode "CONTINUOUS", "RELEASE", or "SETTLE"
+    void setTrackingMode(const QString &mode);
+
+    //! Set the maximum continuous emission rate in Hz, 0 for no limit
+    void setMaxRate(const double rate);
+
+    //! Set the settle time in milliseconds
+    void setSettleTime(const int ms);
+
 private slots:
     void handleIntValueChanged(const int);
+    void handleSliderReleased(void);
+    void emitPending(void);
 
 private:
     void updateRange(const double oldValue);
@@ -29,4 +56,12 @@ private:
     double _minimum;
     double _maximum;
     double _stepSize;
+
+    //tracking policy state
+    QString _trackingMode;
+    double _maxRate;
+    int _settleTime;
+    QTimer *_emitTimer;
+    QElapsedTimer _lastEmit;
+    bool _pending;
 };
@@ -2,11 +2,89 @@
 // SPDX-License-Identifier: BSL-1.0
 
 #include <Pothos/Framework.hpp>
+#include <Pothos/Testing.hpp>
 #include "MyDoubleSlider.hpp"
+#include "StreamRamp.hpp"
+#include "ControlLabeler.hpp"
+#include "ValueMirror.hpp"
 #include <QDoubleSpinBox>
 #include <QLabel>
 #include <QHBoxLayout>
 #include <QVBoxLayout>
+#include <QTimer>
+#include <algorithm> //min/max
+#include <atomic>
+#include <cmath> //llround
+#include <limits>
+
+/***********************************************************************
+ * The value of the numeric entry as an integer number of steps above the minimum.
+ * Both controls are snapped to the value of the nearest step index,
+ * so values can be compared exactly, without floating point tolerance.
+ **********************************************************************/
+class StepIndexModel
+{
+public:
+    StepIndexModel(void):
+        _minimum(0.0),
+        _maximum(100.0),
+        _step(1.0)
+    {
+        return;
+    }
+
+    void setMinimum(const double min)
+    {
+        _minimum = min;
+    }
+
+    void setMaximum(const double max)
+    {
+        _maximum = max;
+    }
+
+    void setStep(const double step)
+    {
+        _step = step;
+    }
+
+    //! The nearest step index for the value, clipped to the range
+    long long index(const double value) const
+    {
+        const long long maxIndex = std::max(std::llround((_maximum-_minimum)/_step), 0ll);
+        return std::min(std::max(std::llround((value-_minimum)/_step), 0ll), maxIndex);
+    }
+
+    //! The canonical value of a step index
+    double value(const long long index) const
+    {
+        return _minimum + index*_step;
+    }
+
+private:
+    double _minimum;
+    double _maximum;
+    double _step;
+};
+
+POTHOS_TEST_BLOCK("/widgets/tests", test_step_index_model)
+{
+    StepIndexModel model;
+    model.setMinimum(-1.0);
+    model.setMaximum(1.0);
+    model.setStep(0.01);
+
+    //nearby values from the spin box and slider paths land on the same step
+    POTHOS_TEST_EQUAL(model.index(0.25), 125ll);
+    POTHOS_TEST_EQUAL(model.index(0.2500000001), 125ll);
+    POTHOS_TEST_EQUAL(model.index(0.2499999999), 125ll);
+    POTHOS_TEST_EQUAL(model.value(model.index(0.25)), model.value(125));
+
+    //out of range values are clipped
+    POTHOS_TEST_EQUAL(model.index(-5.0), 0ll);
+    POTHOS_TEST_EQUAL(model.index(5.0), 200ll);
+    POTHOS_TEST_EQUAL(model.value(0), -1.0);
+}
 
 /***********************************************************************
  * |PothosDoc Numeric Entry
@@ -14,9 +92,27 @@
  * The numeric entry widget display's a numeric value in a text-entry box
  * with increment and decrement buttons.
  *
+ * The value is snapped to a whole number of steps above the minimum,
+ * and the "valueChanged" signal is only emitted when the snapped value changes.
+ * An optional debounce time merges rapid changes into a single emission.
+ *
+ * The numeric entry can optionally output its value as a stream of samples.
+ * The stream follows the slider as it moves, regardless of the tracking mode.
+ *
  * |category /Widgets
  * |keywords numeric entry spinbox
  *
+ * |param portMode [Port Mode] Enable optional stream ports.
+ * The stream source outputs the current value continuously as float64 samples.
+ * The stream passthrough forwards an input stream to the output without copying,
+ * and each emitted value change is marked by a "valueChanged" label carrying the new value,
+ * at the first sample of the next forwarded buffer.
+ * |default "NONE"
+ * |option [None] "NONE"
+ * |option [Stream Source] "SOURCE"
+ * |option [Stream Passthrough] "PASSTHROUGH"
+ * |preview disable
+ *
  * |param title The name of the value displayed by this widget
  * |default "My Numeric Value"
  * |widget StringEntry()
@@ -44,8 +140,42 @@
  * |option [Hide Slider] false
  * |preview disable
  *
+ * |param debounce [Debounce] Emit the value once it has not changed for this long.
+ * Use 0 to emit every change immediately.
+ * |units ms
+ * |default 0
+ * |preview disable
+ *
+ * |param tracking [Tracking] When value changes are emitted while the slider is dragged.
+ * Continuous emits as the slider moves, limited by the max rate.
+ * On release emits once when the slider is released.
+ * On settle emits once the slider has stopped moving for the settle time.
+ * |default "CONTINUOUS"
+ * |option [Continuous] "CONTINUOUS"
+ * |option [On Release] "RELEASE"
+ * |option [On Settle] "SETTLE"
+ * |preview disable
+ *
+ * |param maxRate [Max Rate] The maximum number of value changes emitted per second in continuous mode.
+ * Use 0 for no limit.
+ * |units Hz
+ * |default 0.0
+ * |preview when(enum=tracking, "CONTINUOUS")
+ *
+ * |param settleTime [Settle Time] How long the slider must be still before the value is emitted in settle mode.
+ * |units ms
+ * |default 100
+ * |preview when(enum=tracking, "SETTLE")
+ *
+ * |param rampLength [Ramp Length] The number of samples to ramp over when the value changes.
+ * The stream output moves linearly from the old value to the new value
+ * so that changes do not cause discontinuities. Use 0 to change immediately.
+ * |units samples
+ * |default 0
+ * |preview when(enum=portMode, "SOURCE")
+ *
  * |mode graphWidget
- * |factory /widgets/numeric_entry()
+ * |factory /widgets/numeric_entry(portMode)
  * |setter setTitle(title)
  * |setter setMinimum(minimum)
  * |setter setMaximum(maximum)
@@ -53,21 +183,31 @@
  * |setter setDecimals(precision)
  * |setter setValue(value)
  * |setter setSliderVisible(sliderVisible)
+ * |setter setDebounce(debounce)
+ * |setter setTracking(tracking)
+ * |setter setMaxRate(maxRate)
+ * |setter setSettleTime(settleTime)
+ * |setter setRampLength(rampLength)
  **********************************************************************/
 class NumericEntry : public QWidget, public Pothos::Block
 {
     Q_OBJECT
 public:
 
-    static Block *make(void)
+    static Block *make(const std::string &portMode)
     {
-        return new NumericEntry();
+        return new NumericEntry(portMode);
     }
 
-    NumericEntry(void):
+    NumericEntry(const std::string &portMode):
         _label(new QLabel(this)),
         _spinBox(new QDoubleSpinBox(this)),
-        _slider(new MyDoubleSlider(Qt::Horizontal, this))
+        _slider(new MyDoubleSlider(Qt::Horizontal, this)),
+        _labeler("valueChanged"),
+        _passthrough(portMode == "PASSTHROUGH"),
+        _emittedValue(std::numeric_limits<double>::quiet_NaN()),
+        _debounce(0),
+        _debounceTimer(new QTimer(this))
     {
         auto vlayout = new QVBoxLayout(this);
         auto hlayout = new QHBoxLayout();
@@ -89,10 +229,25 @@ public:
         this->registerCall(this, POTHOS_FCN_TUPLE(NumericEntry, setDecimals));
         this->registerCall(this, POTHOS_FCN_TUPLE(NumericEntry, setSingleStep));
         this->registerCall(this, POTHOS_FCN_TUPLE(NumericEntry, setSliderVisible));
+        this->registerCall(this, POTHOS_FCN_TUPLE(NumericEntry, setDebounce));
+        this->registerCall(this, POTHOS_FCN_TUPLE(NumericEntry, setTracking));
+        this->registerCall(this, POTHOS_FCN_TUPLE(NumericEntry, setMaxRate));
+        this->registerCall(this, POTHOS_FCN_TUPLE(NumericEntry, setSettleTime));
+        this->registerCall(this, POTHOS_FCN_TUPLE(NumericEntry, setRampLength));
 
         this->registerSignal("valueChanged");
+        _debounceTimer->setSingleShot(true);
+        connect(_debounceTimer, &QTimer::timeout, this, &NumericEntry::emitIfChanged);
         connect(_spinBox, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &NumericEntry::handleSpinBoxValueChanged);
+        connect(_slider, &QSlider::valueChanged, this, &NumericEntry::handleSliderMoved);
         connect(_slider, &MyDoubleSlider::valueChanged, this, &NumericEntry::handleSliderValueChanged);
+        if (portMode == "SOURCE") this->setupOutput(0, "float64");
+        else if (portMode == "PASSTHROUGH")
+        {
+            this->setupInput(0);
+            this->setupOutput(0);
+        }
+        else if (portMode != "NONE") throw Pothos::InvalidArgumentException("NumericEntry("+portMode+")", "unknown port mode");
     }
 
     QWidget *widget(void)
@@ -103,12 +258,22 @@ public:
     void activate(void)
     {
         //emit current value when design becomes active
+        _emittedValue = this->value();
         this->emitSignal("valueChanged", this->value());
+        _stream.setValue(this->value());
+        _labeler.setValue(Pothos::Object(this->value()));
+    }
+
+    void work(void)
+    {
+        if (this->outputs().empty()) return;
+        if (_passthrough) _labeler.work(this->input(0), this->output(0));
+        else _stream.work(this->output(0));
     }
 
     double value(void) const
     {
-        return _spinBox->value();
+        return _value.load();
     }
 
     void setTitle(const QString &title)
@@ -120,20 +285,25 @@ public:
 
     void setValue(const double val)
     {
-        _spinBox->setValue(val);
-        _slider->setValue(val);
+        //publish the snapped value now, activate() may run before the queued slot
+        const auto snapped = _setterModel.value(_setterModel.index(val));
+        _value.store(snapped);
+        _stream.setValue(snapped);
+
+        //the debounce and slider timers belong to the GUI thread, forward to the value slot
+        QMetaObject::invokeMethod(this, "handleSetValue", Qt::QueuedConnection, Q_ARG(double, val));
     }
 
     void setMinimum(const double min)
     {
-        _spinBox->setMinimum(min);
-        _slider->setMinimum(min);
+        _setterModel.setMinimum(min);
+        QMetaObject::invokeMethod(this, "handleSetMinimum", Qt::QueuedConnection, Q_ARG(double, min));
     }
 
     void setMaximum(const double max)
     {
-        _spinBox->setMaximum(max);
-        _slider->setMaximum(max);
+        _setterModel.setMaximum(max);
+        QMetaObject::invokeMethod(this, "handleSetMaximum", Qt::QueuedConnection, Q_ARG(double, max));
     }
 
     void setDecimals(const int prec)
@@ -143,8 +313,9 @@ public:
 
     void setSingleStep(const double val)
     {
-        _spinBox->setSingleStep(val);
-        _slider->setSingleStep(val);
+        if (val <= 0.0) throw Pothos::RangeException("NumericEntry::setSingleStep()", "step size must be positive");
+        _setterModel.setStep(val);
+        QMetaObject::invokeMethod(this, "handleSetSingleStep", Qt::QueuedConnection, Q_ARG(double, val));
     }
 
     void setSliderVisible(const bool visible)
@@ -152,6 +323,32 @@ public:
         QMetaObject::invokeMethod(_slider, "setVisible", Qt::QueuedConnection, Q_ARG(bool, visible));
     }
 
+    void setDebounce(const int ms)
+    {
+        _debounce = ms;
+    }
+
+    void setTracking(const QString &mode)
+    {
+        if (mode != "CONTINUOUS" and mode != "RELEASE" and mode != "SETTLE") throw Pothos::InvalidArgumentException("NumericEntry::setTracking("+mode.toStdString()+")", "unknown tracking mode");
+        QMetaObject::invokeMethod(_slider, "setTrackingMode", Qt::QueuedConnection, Q_ARG(QString, mode));
+    }
+
+    void setMaxRate(const double rate)
+    {
+        QMetaObject::invokeMethod(_slider, "setMaxRate", Qt::QueuedConnection, Q_ARG(double, rate));
+    }
+
+    void setSettleTime(const int ms)
+    {
+        QMetaObject::invokeMethod(_slider, "setSettleTime", Qt::QueuedConnection, Q_ARG(int, ms));
+    }
+
+    void setRampLength(const size_t length)
+    {
+        _stream.setRampLength(length);
+    }
+
 public slots:
 
     QVariant saveState(void) const
@@ -161,30 +358,111 @@ public slots:
 
     void restoreState(const QVariant &state)
     {
-        this->setValue(state.toDouble());
+        //already in the GUI thread, the slot publishes the value
+        this->handleSetValue(state.toDouble());
     }
 
 private slots:
+    void handleSetValue(const double val)
+    {
+        _spinBox->setValue(val);
+        _slider->setValue(val);
+    }
+
+    void handleSetMinimum(const double min)
+    {
+        _model.setMinimum(min);
+        _spinBox->setMinimum(min);
+        _slider->setMinimum(min);
+        this->rebaseIndex();
+    }
+
+    void handleSetMaximum(const double max)
+    {
+        _model.setMaximum(max);
+        _spinBox->setMaximum(max);
+        _slider->setMaximum(max);
+        this->rebaseIndex();
+    }
+
+    void handleSetSingleStep(const double val)
+    {
+        _model.setStep(val);
+        _spinBox->setSingleStep(val);
+        _slider->setSingleStep(val);
+        this->rebaseIndex();
+    }
+
     void handleSpinBoxValueChanged(const double value)
     {
-        _slider->blockSignals(true);
-        _slider->setValue(value);
-        _slider->blockSignals(false);
-        this->emitSignal("valueChanged", value);
+        this->commitIndex(_model.index(value));
     }
 
-    void handleSliderValueChanged(const double value)
+    void handleSliderMoved(const int)
     {
+        //the entry follows the slider even when the emission is held back by the tracking mode
+        const auto value = _model.value(_model.index(_slider->value()));
         _spinBox->blockSignals(true);
         _spinBox->setValue(value);
         _spinBox->blockSignals(false);
+        _stream.setValue(value);
+    }
+
+    void handleSliderValueChanged(const double value)
+    {
+        this->commitIndex(_model.index(value));
+    }
+
+    void emitIfChanged(void)
+    {
+        //compare canonical values, step indexes are re-based by range and step changes
+        const auto value = _value.load();
+        if (value == _emittedValue) return;
+        _emittedValue = value;
+        _labeler.setValue(Pothos::Object(value));
         this->emitSignal("valueChanged", value);
     }
 
 private:
+    //snap the current value onto the step grid of the new range or step
+    void rebaseIndex(void)
+    {
+        this->commitIndex(_model.index(_value.load()));
+    }
+
+    void commitIndex(const long long index)
+    {
+        //snap both controls to the canonical value of the step
+        const auto value = _model.value(index);
+        _value.store(value);
+        _spinBox->blockSignals(true);
+        _slider->blockSignals(true);
+        _spinBox->setValue(value);
+        _slider->setValue(value);
+        _spinBox->blockSignals(false);
+        _slider->blockSignals(false);
+        _stream.setValue(value);
+
+        if (_debounce > 0) _debounceTimer->start(_debounce);
+        else this->emitIfChanged();
+    }
+
     QLabel *_label;
     QDoubleSpinBox *_spinBox;
     MyDoubleSlider *_slider;
+    StreamRamp<double> _stream;
+    ControlLabeler _labeler;
+    bool _passthrough;
+
+    //step index model, only used in the GUI thread
+    StepIndexModel _model;
+
+    //a copy of the model for the block thread setters, only used by the block thread
+    StepIndexModel _setterModel;
+    std::atomic<double> _emittedValue;
+    std::atomic<int> _debounce;
+    QTimer *_debounceTimer;
+    ValueMirror<double> _value;
 };
 
 static Pothos::BlockRegistry registerNumericEntry(
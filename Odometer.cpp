@@ -3,10 +3,24 @@
 
 #include <Pothos/Framework.hpp>
 #include "indicator.h"
+#include "DerivedValue.hpp"
+#include "ValueMirror.hpp"
 #include <QVariant>
 #include <QGroupBox>
 #include <QVBoxLayout>
 #include <QMouseEvent>
+#include <QTimer>
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QImage>
+#include <QThread>
+#include <Pothos/Testing.hpp>
+#include <iostream>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <algorithm> //max
+#include <cmath> //llround
 
 /***********************************************************************
  * |PothosDoc Odometer
@@ -16,8 +30,23 @@
  * and clock on the bottom half of a digit to decrease its value by one.
  * The odometer can also be used for display via the setValue slot.
  *
+ * The derived mode displays the delta or rate of change
+ * of the values passed to setValue(), such as monotonic counters.
+ *
+ * The odometer can optionally count the elements or bytes of an input stream.
+ * The count is polled by the display at the display rate,
+ * so the stream is not slowed down by display updates.
+ *
  * |category /Widgets
- * |keywords spin frequency
+ * |keywords spin frequency counter throughput
+ *
+ * |param portMode [Port Mode] Enable an optional stream input port.
+ * The stream counter consumes the input and displays the running total,
+ * or its delta or rate of change in the derived modes.
+ * |default "NONE"
+ * |option [None] "NONE"
+ * |option [Stream Counter] "STREAM"
+ * |preview disable
  *
  * |param title The name of the value displayed by this widget
  * |default "Digit Value"
@@ -33,6 +62,31 @@
  * |widget SpinBox(minimum=1)
  * |preview disable
  *
+ * |param renderMode [Render Mode] How the digits are drawn.
+ * The widgets mode uses a label widget for each digit.
+ * The painted mode draws all of the digits in one widget
+ * from glyphs that are rendered once per font size and shared between odometers,
+ * which saves memory and repaint time for panels with many odometers.
+ * |default "WIDGETS"
+ * |option [Widgets] "WIDGETS"
+ * |option [Painted] "PAINTED"
+ * |preview disable
+ *
+ * |param derivedMode [Derived Mode] Display a value derived from successive setValue() calls.
+ * The delta mode displays the difference since the last value.
+ * The rate mode displays the difference per second since the last value.
+ * The smoothed rate mode averages the rate with an exponentially weighted moving average.
+ * |default "VALUE"
+ * |option [Value] "VALUE"
+ * |option [Delta] "DELTA"
+ * |option [Rate] "RATE"
+ * |option [Smoothed Rate] "EWMA"
+ * |preview disable
+ *
+ * |param smoothing The weight of each new rate in the smoothed rate mode.
+ * |default 0.2
+ * |preview when(enum=derivedMode, "EWMA")
+ *
  * |param value The initial value of this odometer.
  * |default 123456789
  *
@@ -42,27 +96,49 @@
  * |param maximum The maximum value of this odometer.
  * |default 1e9
  *
+ * |param countUnits [Count Units] What the stream counter counts.
+ * |default "ELEMENTS"
+ * |option [Elements] "ELEMENTS"
+ * |option [Bytes] "BYTES"
+ * |preview when(enum=portMode, "STREAM")
+ *
+ * |param displayRate [Display Rate] The number of times per second the stream count is displayed.
+ * |units Hz
+ * |default 10.0
+ * |preview when(enum=portMode, "STREAM")
+ *
  * |mode graphWidget
- * |factory /widgets/odometer()
+ * |factory /widgets/odometer(portMode)
  * |setter setTitle(title)
+ * |setter setRenderMode(renderMode)
  * |setter setFontSize(fontSize)
  * |setter setSize(size)
  * |setter setValueMin(minimum)
  * |setter setValueMax(maximum)
+ * |setter setDerivedMode(derivedMode)
+ * |setter setSmoothing(smoothing)
  * |setter setValue(value)
+ * |setter setCountUnits(countUnits)
+ * |setter setDisplayRate(displayRate)
  **********************************************************************/
 class Odometer : public QGroupBox, public Pothos::Block
 {
     Q_OBJECT
 public:
 
-    static Block *make(void)
+    static Block *make(const std::string &portMode)
     {
-        return new Odometer();
+        return new Odometer(portMode);
     }
 
-    Odometer(void):
-        _indicator(new Indicator())
+    Odometer(const std::string &portMode):
+        _indicator(new Indicator()),
+        _pollTimer(nullptr),
+        _count(0),
+        _countBytes(false),
+        _lastCount(0),
+        _valueMin(0),
+        _valueMax(0)
     {
         _indicator->setFrameShape(QFrame::NoFrame);
         _indicator->setFrameShadow(QFrame::Plain);
@@ -75,13 +151,27 @@ public:
         this->registerCall(this, POTHOS_FCN_TUPLE(Odometer, setTitle));
         this->registerCall(this, POTHOS_FCN_TUPLE(Odometer, setFontSize));
         this->registerCall(this, POTHOS_FCN_TUPLE(Odometer, setSize));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Odometer, setRenderMode));
         this->registerCall(this, POTHOS_FCN_TUPLE(Odometer, widget));
         this->registerCall(this, POTHOS_FCN_TUPLE(Odometer, value));
         this->registerCall(this, POTHOS_FCN_TUPLE(Odometer, setValue));
         this->registerCall(this, POTHOS_FCN_TUPLE(Odometer, setValueMin));
         this->registerCall(this, POTHOS_FCN_TUPLE(Odometer, setValueMax));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Odometer, setDerivedMode));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Odometer, setSmoothing));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Odometer, setCountUnits));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Odometer, setDisplayRate));
         this->registerSignal("valueChanged");
         connect(_indicator, &Indicator::valueChanged, this, &Odometer::handleValueChanged);
+
+        if (portMode == "STREAM")
+        {
+            this->setupInput(0);
+            _pollTimer = new QTimer(this);
+            _pollTimer->setInterval(100);
+            connect(_pollTimer, &QTimer::timeout, this, &Odometer::handlePollCount);
+        }
+        else if (portMode != "NONE") throw Pothos::InvalidArgumentException("Odometer("+portMode+")", "unknown port mode");
     }
 
     QWidget *widget(void)
@@ -104,30 +194,105 @@ public:
         QMetaObject::invokeMethod(_indicator, "setSize", Qt::QueuedConnection, Q_ARG(int, size));
     }
 
+    void setRenderMode(const std::string &mode)
+    {
+        if (mode != "WIDGETS" and mode != "PAINTED") throw Pothos::InvalidArgumentException("Odometer::setRenderMode("+mode+")", "unknown render mode");
+        QMetaObject::invokeMethod(_indicator, "setPainted", Qt::QueuedConnection, Q_ARG(bool, mode == "PAINTED"));
+    }
+
     qint64 value(void) const
     {
-        return _indicator->value();
+        return _value.load();
     }
 
     void setValue(const qint64 value)
     {
-        _indicator->setValue(value);
+        qint64 displayValue = value;
+        {
+            std::lock_guard<std::mutex> lock(_derivedMutex);
+            if (_derived.mode() != DerivedValue::VALUE) displayValue = std::llround(_derived.update(double(value)));
+        }
+
+        //the indicator ignores values out of range, publish the value for the getter now
+        //because the indicator is updated later in the GUI thread
+        if (displayValue >= _valueMin and displayValue <= _valueMax) _value.store(displayValue);
+        QMetaObject::invokeMethod(_indicator, "setValue", Qt::QueuedConnection, Q_ARG(qint64, displayValue));
     }
 
     void setValueMin(const qint64 value)
     {
-        _indicator->setValueMin(value);
+        //the indicator ignores a minimum above the maximum, and raises the value to the minimum
+        if (value > _valueMax) return;
+        _valueMin = value;
+        if (_value.load() < value) _value.store(value);
+        QMetaObject::invokeMethod(_indicator, "setValueMin", Qt::QueuedConnection, Q_ARG(qint64, value));
     }
 
     void setValueMax(const qint64 value)
     {
-        _indicator->setValueMax(value);
+        if (value < _valueMin) return;
+        _valueMax = value;
+        if (_value.load() > value) _value.store(value);
+        QMetaObject::invokeMethod(_indicator, "setValueMax", Qt::QueuedConnection, Q_ARG(qint64, value));
+    }
+
+    void setDerivedMode(const std::string &mode)
+    {
+        std::lock_guard<std::mutex> lock(_derivedMutex);
+        _derived.setMode(mode);
+    }
+
+    void setSmoothing(const double alpha)
+    {
+        std::lock_guard<std::mutex> lock(_derivedMutex);
+        _derived.setSmoothing(alpha);
+    }
+
+    void setCountUnits(const std::string &units)
+    {
+        if (units == "ELEMENTS") _countBytes = false;
+        else if (units == "BYTES") _countBytes = true;
+        else throw Pothos::InvalidArgumentException("Odometer::setCountUnits("+units+")", "unknown count units");
+    }
+
+    void setDisplayRate(const double rate)
+    {
+        if (rate <= 0.0) throw Pothos::RangeException("Odometer::setDisplayRate()", "rate must be positive");
+        if (_pollTimer == nullptr) return;
+        QMetaObject::invokeMethod(this, "handleSetPollInterval", Qt::QueuedConnection, Q_ARG(int, std::max(1, int(1000.0/rate))));
     }
 
     void activate(void)
     {
         //emit current value when design becomes active
         this->emitSignal("valueChanged", this->value());
+
+        //the stream count starts over with each activation
+        if (_pollTimer == nullptr) return;
+        _count.store(0);
+        QMetaObject::invokeMethod(this, "handleStartCount", Qt::QueuedConnection);
+    }
+
+    void deactivate(void)
+    {
+        //display the final count before the timer stops
+        if (_pollTimer == nullptr) return;
+        QMetaObject::invokeMethod(this, "handlePollCount", Qt::QueuedConnection);
+        QMetaObject::invokeMethod(_pollTimer, "stop", Qt::QueuedConnection);
+    }
+
+    void work(void)
+    {
+        if (this->inputs().empty()) return;
+        auto inPort = this->input(0);
+        while (inPort->hasMessage()) inPort->popMessage();
+        const size_t elems = inPort->elements();
+        if (elems == 0) return;
+
+        //one relaxed add per buffer, the display polls the total
+        const size_t count = _countBytes? inPort->buffer().length : elems;
+        _count.fetch_add(count, std::memory_order_relaxed);
+        inPort->consume(elems);
     }
 
 public slots:
@@ -139,12 +304,13 @@ public slots:
 
     void restoreState(const QVariant &state)
     {
-        this->setValue(state.toLongLong());
+        _indicator->setValue(state.toLongLong());
     }
 
 private slots:
     void handleValueChanged(const qint64 value)
     {
+        _value.store(value);
         this->emitSignal("valueChanged", value);
     }
 
@@ -153,6 +319,31 @@ private slots:
         QGroupBox::setTitle(title);
     }
 
+    void handleSetPollInterval(const int ms)
+    {
+        _pollTimer->setInterval(ms);
+    }
+
+    void handleStartCount(void)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_derivedMutex);
+            _derived.reset();
+        }
+        _lastCount = 0;
+        this->setValue(0);
+        _pollTimer->start();
+    }
+
+    void handlePollCount(void)
+    {
+        //an unchanged count still updates the derived modes, the rate falls to zero
+        const auto count = _count.load(std::memory_order_relaxed);
+        if (count == _lastCount and this->derivedMode() == DerivedValue::VALUE) return;
+        _lastCount = count;
+        this->setValue(qint64(count));
+    }
+
 protected:
     void mousePressEvent(QMouseEvent *event)
     {
@@ -161,9 +352,80 @@ protected:
     }
 
 private:
+    DerivedValue::Mode derivedMode(void)
+    {
+        std::lock_guard<std::mutex> lock(_derivedMutex);
+        return _derived.mode();
+    }
+
     Indicator *_indicator;
+
+    //the block thread setters and the GUI thread stream counter share the derived state
+    std::mutex _derivedMutex;
+    DerivedValue _derived;
+    ValueMirror<qint64> _value;
+    QTimer *_pollTimer;
+    std::atomic<unsigned long long> _count;
+    std::atomic<bool> _countBytes;
+    unsigned long long _lastCount;
+
+    //the indicator range requested by the setters, for the published value
+    std::atomic<qint64> _valueMin;
+    std::atomic<qint64> _valueMax;
 };
 
+/***********************************************************************
+ * Compare the widget count and repaint time of both render modes
+ **********************************************************************/
+POTHOS_TEST_BLOCK("/widgets/tests", test_odometer_render_benchmark)
+{
+    const auto app = qobject_cast<QApplication *>(QCoreApplication::instance());
+    if (app == nullptr or app->thread() != QThread::currentThread())
+    {
+        std::cout << "Skipped, rendering widgets requires the QApplication thread" << std::endl;
+        return;
+    }
+
+    //a panel of twenty 12 digit odometers
+    static const int numIndicators = 20;
+    static const int numDigits = 12;
+    static const int numIters = 100;
+    for (const bool painted : {false, true})
+    {
+        std::vector<std::unique_ptr<Indicator>> indicators;
+        int numWidgets = 0;
+        for (int i = 0; i < numIndicators; i++)
+        {
+            indicators.emplace_back(new Indicator());
+            auto indicator = indicators.back().get();
+            indicator->setPainted(painted);
+            indicator->setFontSize(12);
+            indicator->setSize(numDigits);
+            indicator->setValueMax(999999999999);
+            indicator->resize(indicator->sizeHint());
+            numWidgets += indicator->findChildren<QWidget *>().size()+1;
+        }
+
+        QImage image(indicators.front()->size(), QImage::Format_ARGB32_Premultiplied);
+        QElapsedTimer timer;
+        timer.start();
+        for (int iter = 0; iter < numIters; iter++)
+        {
+            for (auto &indicator : indicators)
+            {
+                indicator->setValue(qint64(iter)*7919);
+                indicator->render(&image);
+            }
+        }
+        const auto elapsedNs = timer.nsecsElapsed();
+
+        std::cout << (painted?"Painted":"Widgets") << " mode: "
+            << (numWidgets/numIndicators) << " widgets/odometer, "
+            << indicators.front()->atlasBytes() << " shared glyph bytes, "
+            << (elapsedNs/(numIters*numIndicators)) << " ns/repaint" << std::endl;
+    }
+}
+
 static Pothos::BlockRegistry registerOdometer(
     "/widgets/odometer", &Odometer::make);
 
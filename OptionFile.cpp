@@ -0,0 +1,318 @@
+// Copyright (c) 2026 agent
+// SPDX-License-Identifier: BSL-1.0
+
+#include "OptionFile.hpp"
+#include <Pothos/Exception.hpp>
+#include <Pothos/Testing.hpp>
+#include <QTemporaryDir>
+#include <QFileInfo>
+#include <QFile>
+#include <algorithm> //count
+#include <cstring> //memchr
+#include <climits> //INT_MIN/MAX
+
+/***********************************************************************
+ * Parsing helpers
+ **********************************************************************/
+struct OptionScanner
+{
+    OptionScanner(const char *data, const size_t length, const std::string &where):
+        p(data), end(data+length), line(1), where(where)
+    {
+        //skip the UTF-8 byte order mark
+        if (length >= 3 and std::memcmp(p, "\xEF\xBB\xBF", 3) == 0) p += 3;
+    }
+
+    [[noreturn]] void fail(const std::string &what) const
+    {
+        throw Pothos::DataFormatException(where, "line "+std::to_string(line)+": "+what);
+    }
+
+    void skipSpaces(void)
+    {
+        while (p != end and (*p == ' ' or *p == '\t' or *p == '\r')) p++;
+    }
+
+    bool atLineEnd(void) const
+    {
+        return p == end or *p == '\n';
+    }
+
+    void expect(const char ch, const std::string &what)
+    {
+        this->skipSpaces();
+        if (p == end or *p != ch) this->fail(what);
+        p++;
+    }
+
+    void nextLine(void)
+    {
+        this->skipSpaces();
+        if (not this->atLineEnd()) this->fail("unexpected text after the record");
+        if (p != end) p++;
+        line++;
+    }
+
+    const char *p;
+    const char *end;
+    size_t line;
+    const std::string &where;
+};
+
+//! Parse a number or boolean token, false when the token is neither
+static bool parseToken(const QByteArray &token, Pothos::Object &value)
+{
+    if (token == "true") value = Pothos::Object(true);
+    else if (token == "false") value = Pothos::Object(false);
+    else
+    {
+        bool ok(false);
+        const auto integer = token.toLongLong(&ok);
+        if (ok and integer >= INT_MIN and integer <= INT_MAX) value = Pothos::Object(int(integer));
+        else if (ok) value = Pothos::Object(integer);
+        else
+        {
+            const auto number = token.toDouble(&ok);
+            if (not ok) return false;
+            value = Pothos::Object(number);
+        }
+    }
+    return true;
+}
+
+static QByteArray csvField(OptionScanner &s, bool &quoted)
+{
+    s.skipSpaces();
+    quoted = s.p != s.end and *s.p == '"';
+    if (not quoted)
+    {
+        const char *begin = s.p;
+        while (s.p != s.end and *s.p != ',' and *s.p != '\n') s.p++;
+        return QByteArray(begin, int(s.p-begin)).trimmed();
+    }
+
+    //copy the runs between quotes, a doubled quote is a literal quote
+    QByteArray field;
+    s.p++;
+    while (true)
+    {
+        const auto quote = static_cast<const char *>(std::memchr(s.p, '"', size_t(s.end-s.p)));
+        if (quote == nullptr) s.fail("unterminated quoted field");
+        s.line += size_t(std::count(s.p, quote, '\n'));
+        field.append(s.p, int(quote-s.p));
+        s.p = quote+1;
+        if (s.p == s.end or *s.p != '"') break;
+        field.append('"');
+        s.p++;
+    }
+    s.skipSpaces();
+    return field;
+}
+
+static void appendUtf8(QByteArray &out, const uint code)
+{
+    if (code < 0x80) out.append(char(code));
+    else if (code < 0x800)
+    {
+        out.append(char(0xC0 | (code >> 6)));
+        out.append(char(0x80 | (code & 0x3F)));
+    }
+    else if (code < 0x10000)
+    {
+        out.append(char(0xE0 | (code >> 12)));
+        out.append(char(0x80 | ((code >> 6) & 0x3F)));
+        out.append(char(0x80 | (code & 0x3F)));
+    }
+    else
+    {
+        out.append(char(0xF0 | (code >> 18)));
+        out.append(char(0x80 | ((code >> 12) & 0x3F)));
+        out.append(char(0x80 | ((code >> 6) & 0x3F)));
+        out.append(char(0x80 | (code & 0x3F)));
+    }
+}
+
+static QByteArray jsonString(OptionScanner &s)
+{
+    s.expect('"', "expected a string");
+    QByteArray out;
+    while (true)
+    {
+        if (s.atLineEnd()) s.fail("unterminated string");
+        const char ch = *s.p++;
+        if (ch == '"') break;
+        if (ch != '\\')
+        {
+            out.append(ch);
+            continue;
+        }
+        if (s.p == s.end) s.fail("unterminated string");
+        const char esc = *s.p++;
+        switch (esc)
+        {
+        case '"': case '\\': case '/': out.append(esc); break;
+        case 'b': out.append('\b'); break;
+        case 'f': out.append('\f'); break;
+        case 'n': out.append('\n'); break;
+        case 'r': out.append('\r'); break;
+        case 't': out.append('\t'); break;
+        case 'u':
+        {
+            auto hex4 = [&s](void)
+            {
+                if (s.end-s.p < 4) s.fail("bad unicode escape");
+                bool ok(false);
+                const auto code = QByteArray(s.p, 4).toUInt(&ok, 16);
+                if (not ok) s.fail("bad unicode escape");
+                s.p += 4;
+                return code;
+            };
+            uint code = hex4();
+            if (code >= 0xD800 and code < 0xDC00 and s.end-s.p >= 6 and s.p[0] == '\\' and s.p[1] == 'u')
+            {
+                s.p += 2;
+                code = 0x10000 + ((code-0xD800) << 10) + (hex4()-0xDC00);
+            }
+            appendUtf8(out, code);
+            break;
+        }
+        default: s.fail("bad escape sequence");
+        }
+    }
+    return out;
+}
+
+/***********************************************************************
+ * Option file implementation
+ **********************************************************************/
+OptionFile::OptionFile(void):
+    _size(0)
+{
+    return;
+}
+
+OptionSetPtr OptionFile::load(const QString &path, const std::string &where)
+{
+    if (path.isEmpty())
+    {
+        _path.clear();
+        return nullptr;
+    }
+
+    //skip the parse when the same file was not modified since the last load
+    const QFileInfo info(path);
+    const auto modified = info.lastModified();
+    if (path == _path and modified == _modified and info.size() == _size) return nullptr;
+
+    QFile file(path);
+    if (not file.open(QIODevice::ReadOnly))
+    {
+        throw Pothos::OpenFileException(where, path.toStdString()+": "+file.errorString().toStdString());
+    }
+    const auto suffix = info.suffix().toLower();
+    const bool jsonLines = suffix == "jsonl" or suffix == "ndjson";
+
+    OptionSetPtr options;
+    const auto data = (file.size() == 0)?nullptr:file.map(0, file.size());
+    if (data != nullptr) options = parse(reinterpret_cast<const char *>(data), size_t(file.size()), jsonLines, where);
+    else
+    {
+        const auto bytes = file.readAll();
+        options = parse(bytes.constData(), size_t(bytes.size()), jsonLines, where);
+    }
+
+    _path = path;
+    _modified = modified;
+    _size = info.size();
+    return options;
+}
+
+OptionSetPtr OptionFile::parse(const char *data, const size_t length, const bool jsonLines, const std::string &where)
+{
+    OptionScanner s(data, length, where);
+    std::vector<QString> titles;
+    std::vector<Pothos::Object> values;
+    while (s.p != s.end)
+    {
+        s.skipSpaces();
+        if (s.atLineEnd())
+        {
+            s.nextLine();
+            continue;
+        }
+
+        QByteArray title;
+        Pothos::Object value;
+        if (jsonLines)
+        {
+            s.expect('[', "expected a [\"title\", value] array");
+            title = jsonString(s);
+            s.expect(',', "expected a [\"title\", value] array");
+            s.skipSpaces();
+            if (s.p != s.end and *s.p == '"') value = Pothos::Object(jsonString(s).toStdString());
+            else
+            {
+                const char *begin = s.p;
+                while (not s.atLineEnd() and *s.p != ']' and *s.p != ' ' and *s.p != '\t' and *s.p != '\r') s.p++;
+                const auto token = QByteArray::fromRawData(begin, int(s.p-begin));
+                if (token != "null" and not parseToken(token, value)) s.fail("value must be a string, number, boolean, or null");
+            }
+            s.expect(']', "expected a [\"title\", value] array");
+        }
+        else
+        {
+            bool quoted(false);
+            title = csvField(s, quoted);
+            s.expect(',', "expected a title,value record");
+            const auto field = csvField(s, quoted);
+            if (quoted or not parseToken(field, value)) value = Pothos::Object(field.toStdString());
+        }
+        s.nextLine();
+        titles.push_back(QString::fromUtf8(title));
+        values.push_back(value);
+    }
+    return OptionSet::make(std::move(titles), std::move(values));
+}
+
+/***********************************************************************
+ * Parse both formats and skip reloading an unchanged file
+ **********************************************************************/
+POTHOS_TEST_BLOCK("/widgets/tests", test_option_file)
+{
+    const std::string csv("Opt0, 42\r\n\n\"Opt, \"\"1\"\"\",xyz\n\"Opt2\",\"42\"\nOpt3,2.5\n");
+    const auto csvOptions = OptionFile::parse(csv.data(), csv.size(), false, "test");
+    POTHOS_TEST_EQUAL(csvOptions->size(), size_t(4));
+    POTHOS_TEST_TRUE(csvOptions->title(1) == "Opt, \"1\"");
+    POTHOS_TEST_EQUAL(csvOptions->value(0).extract<int>(), 42);
+    POTHOS_TEST_EQUAL(csvOptions->value(1).extract<std::string>(), "xyz");
+    POTHOS_TEST_EQUAL(csvOptions->value(2).extract<std::string>(), "42");
+    POTHOS_TEST_EQUAL(csvOptions->value(3).extract<double>(), 2.5);
+
+    const std::string json("[\"Opt0\", 42]\n[\"Opt\\u00e91\", \"xyz\"]\n\n[\"Opt2\", true]\n");
+    const auto jsonOptions = OptionFile::parse(json.data(), json.size(), true, "test");
+    POTHOS_TEST_EQUAL(jsonOptions->size(), size_t(3));
+    POTHOS_TEST_TRUE(jsonOptions->title(1) == QString::fromUtf8("Opt\xC3\xA9" "1"));
+    POTHOS_TEST_EQUAL(jsonOptions->indexOf(Pothos::Object(42)), 0);
+    POTHOS_TEST_EQUAL(jsonOptions->value(2).extract<bool>(), true);
+
+    const std::string bad("[\"Opt0\", 42]\n[\"Opt1\" 42]\n");
+    POTHOS_TEST_THROWS(OptionFile::parse(bad.data(), bad.size(), true, "test"), Pothos::DataFormatException);
+
+    QTemporaryDir dir;
+    POTHOS_TEST_TRUE(dir.isValid());
+    const auto path = dir.filePath("options.csv");
+    {
+        QFile file(path);
+        POTHOS_TEST_TRUE(file.open(QIODevice::WriteOnly));
+        file.write(csv.data(), qint64(csv.size()));
+    }
+    OptionFile optionFile;
+    POTHOS_TEST_TRUE(optionFile.load(path, "test") != nullptr);
+    POTHOS_TEST_TRUE(optionFile.load(path, "test") == nullptr);
+    {
+        QFile file(path);
+        POTHOS_TEST_TRUE(file.open(QIODevice::Append));
+        file.write("Opt4,4\n");
+    }
+    POTHOS_TEST_EQUAL(optionFile.load(path, "test")->size(), size_t(5));
+}
@@ -0,0 +1,45 @@
+// Copyright (c) 2026 agent
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include "OptionModel.hpp"
+#include <QDateTime>
+#include <QString>
+#include <string>
+
+/*!
+ * Load option sets from a local file of title and value pairs.
+ *
+ * A CSV file has one title,value record per line,
+ * and fields that contain commas, quotes, or newlines are double quoted.
+ * A JSON lines file (.jsonl or .ndjson) has one ["title", value] array per line.
+ * Unquoted numbers are loaded as numeric values, whole numbers as integers,
+ * and true/false as booleans; everything else is loaded as a string.
+ *
+ * The file is memory mapped and parsed in the calling thread.
+ * The modification time and size of the last load are remembered,
+ * so loading the same unchanged file again is skipped.
+ */
+class OptionFile
+{
+public:
+    OptionFile(void);
+
+    /*!
+     * Load the options when the file changed since the last load.
+     * \param path the file path or empty for no file
+     * \param where the name of the calling function for error messages
+     * \return the new options, or null when the file is unchanged or the path is empty
+     * \throws OpenFileException when the file cannot be read
+     * \throws DataFormatException for a malformed record
+     */
+    OptionSetPtr load(const QString &path, const std::string &where);
+
+    //! Parse the contents of a CSV or JSON lines file
+    static OptionSetPtr parse(const char *data, const size_t length, const bool jsonLines, const std::string &where);
+
+private:
+    QString _path;
+    QDateTime _modified;
+    qint64 _size;
+};
@@ -0,0 +1,175 @@
+// Copyright (c) 2026 agent
+// SPDX-License-Identifier: BSL-1.0
+
+#include "OptionModel.hpp"
+#include <Pothos/Testing.hpp>
+#include <algorithm> //min
+
+/***********************************************************************
+ * Option set
+ **********************************************************************/
+OptionSet::OptionSet(void)
+{
+    return;
+}
+
+OptionSetPtr OptionSet::make(const Pothos::ObjectVector &options, const std::string &where)
+{
+    std::vector<QString> titles;
+    std::vector<Pothos::Object> values;
+    titles.reserve(options.size());
+    values.reserve(options.size());
+    for (const auto &option : options)
+    {
+        if (not option.canConvert(typeid(Pothos::ObjectVector))) throw Pothos::DataFormatException(where, "entry is not ObjectVector");
+        const auto optPair = option.convert<Pothos::ObjectVector>();
+        if (optPair.size() != 2) throw Pothos::DataFormatException(where, "entry must be ObjectVector of size == 2");
+        if (not optPair.at(0).canConvert(typeid(QString))) throw Pothos::DataFormatException(where, "entry[0] must be a string");
+        titles.push_back(optPair.at(0).convert<QString>());
+        values.push_back(optPair.at(1));
+    }
+    return make(std::move(titles), std::move(values));
+}
+
+OptionSetPtr OptionSet::make(std::vector<QString> &&titles, std::vector<Pothos::Object> &&values)
+{
+    std::shared_ptr<OptionSet> set(new OptionSet());
+    set->_titles = std::move(titles);
+    set->_values = std::move(values);
+    set->buildIndex();
+    return set;
+}
+
+void OptionSet::buildIndex(void)
+{
+    //later rows replace earlier ones so duplicates resolve to the last match
+    _index.clear();
+    _index.reserve(_values.size());
+    for (size_t row = 0; row < _values.size(); row++)
+    {
+        _index[_values[row].toString()] = int(row);
+    }
+}
+
+int OptionSet::indexOf(const Pothos::Object &value) const
+{
+    const auto it = _index.find(value.toString());
+    if (it != _index.end() and _values[it->second].equals(value)) return it->second;
+
+    //equal values may print differently (such as 42 and 42.0), fall back to a scan
+    for (size_t row = _values.size(); row-- > 0;)
+    {
+        if (_values[row].equals(value)) return int(row);
+    }
+    return -1;
+}
+
+bool OptionSet::sameRow(const OptionSet &other, const size_t row, const size_t otherRow) const
+{
+    return _titles[row] == other._titles[otherRow] and _values[row].equals(other._values[otherRow]);
+}
+
+void OptionSet::diff(const OptionSet &oldSet, const OptionSet &newSet, size_t &prefix, size_t &suffix)
+{
+    const size_t oldSize = oldSet.size();
+    const size_t newSize = newSet.size();
+    const size_t maxCommon = std::min(oldSize, newSize);
+    prefix = 0;
+    while (prefix < maxCommon and oldSet.sameRow(newSet, prefix, prefix)) prefix++;
+    suffix = 0;
+    while (suffix < maxCommon-prefix and oldSet.sameRow(newSet, oldSize-suffix-1, newSize-suffix-1)) suffix++;
+}
+
+/***********************************************************************
+ * Option list model
+ **********************************************************************/
+OptionListModel::OptionListModel(QObject *parent):
+    QAbstractListModel(parent),
+    _options(std::make_shared<OptionSet>())
+{
+    return;
+}
+
+int OptionListModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid()) return 0;
+    return int(_options->size());
+}
+
+QVariant OptionListModel::data(const QModelIndex &index, int role) const
+{
+    if (not index.isValid() or size_t(index.row()) >= _options->size()) return QVariant();
+    if (role == Qt::DisplayRole or role == Qt::EditRole) return _options->title(index.row());
+    return QVariant();
+}
+
+void OptionListModel::setOptions(const OptionSetPtr &options)
+{
+    size_t prefix, suffix;
+    OptionSet::diff(*_options, *options, prefix, suffix);
+    const int oldMid = int(_options->size()-prefix-suffix);
+    const int newMid = int(options->size()-prefix-suffix);
+    const int common = std::min(oldMid, newMid);
+    const int first = int(prefix);
+
+    //rows past the common middle are removed or inserted, the rest are updated in place
+    if (oldMid > newMid)
+    {
+        this->beginRemoveRows(QModelIndex(), first+common, first+oldMid-1);
+        _options = options;
+        this->endRemoveRows();
+    }
+    else if (newMid > oldMid)
+    {
+        this->beginInsertRows(QModelIndex(), first+common, first+newMid-1);
+        _options = options;
+        this->endInsertRows();
+    }
+    else _options = options;
+
+    if (common > 0) emit this->dataChanged(this->index(first), this->index(first+common-1));
+}
+
+/***********************************************************************
+ * Check the value index and the diff of option sets
+ **********************************************************************/
+static Pothos::ObjectVector makeTestOptions(const std::vector<int> &values)
+{
+    Pothos::ObjectVector options;
+    for (const auto value : values)
+    {
+        Pothos::ObjectVector optPair;
+        optPair.push_back(Pothos::Object(QString("Opt%1").arg(value)));
+        optPair.push_back(Pothos::Object(value));
+        options.push_back(Pothos::Object(optPair));
+    }
+    return options;
+}
+
+POTHOS_TEST_BLOCK("/widgets/tests", test_option_set)
+{
+    const auto set0 = OptionSet::make(makeTestOptions({1, 2, 3, 4, 5}), "test");
+    POTHOS_TEST_EQUAL(set0->size(), size_t(5));
+    POTHOS_TEST_EQUAL(set0->indexOf(Pothos::Object(3)), 2);
+    POTHOS_TEST_EQUAL(set0->indexOf(Pothos::Object(42)), -1);
+    POTHOS_TEST_TRUE(set0->title(4) == "Opt5");
+
+    //one row replaced in the middle
+    const auto set1 = OptionSet::make(makeTestOptions({1, 2, 9, 4, 5}), "test");
+    size_t prefix, suffix;
+    OptionSet::diff(*set0, *set1, prefix, suffix);
+    POTHOS_TEST_EQUAL(prefix, size_t(2));
+    POTHOS_TEST_EQUAL(suffix, size_t(2));
+
+    //rows appended to the end
+    const auto set2 = OptionSet::make(makeTestOptions({1, 2, 3, 4, 5, 6, 7}), "test");
+    OptionSet::diff(*set0, *set2, prefix, suffix);
+    POTHOS_TEST_EQUAL(prefix, size_t(5));
+    POTHOS_TEST_EQUAL(suffix, size_t(0));
+
+    //identical sets
+    OptionSet::diff(*set0, *set0, prefix, suffix);
+    POTHOS_TEST_EQUAL(prefix+suffix, size_t(5));
+
+    POTHOS_TEST_THROWS(OptionSet::make(Pothos::ObjectVector(1, Pothos::Object(1)), "test"), Pothos::DataFormatException);
+}
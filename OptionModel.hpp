@@ -0,0 +1,101 @@
+// Copyright (c) 2026 agent
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include <Pothos/Object.hpp>
+#include <Pothos/Object/Containers.hpp>
+#include <QAbstractListModel>
+#include <QString>
+#include <unordered_map>
+#include <memory>
+#include <string>
+#include <vector>
+
+class OptionSet;
+typedef std::shared_ptr<const OptionSet> OptionSetPtr;
+
+/*!
+ * An immutable list of options, each a displayable title and a value.
+ * The options are validated and converted once when the set is created,
+ * and then shared between threads by pointer.
+ *
+ * Values are indexed by their string representation,
+ * so finding the row of a value is a hash lookup verified with Object::equals().
+ */
+class OptionSet
+{
+public:
+    //! An empty option set
+    OptionSet(void);
+
+    /*!
+     * Create an option set from an object vector of [title, value] pairs.
+     * \param options the options in the form of the setOptions() parameter
+     * \param where the name of the calling function for error messages
+     * \throws DataFormatException for a malformed entry
+     */
+    static OptionSetPtr make(const Pothos::ObjectVector &options, const std::string &where);
+
+    //! Create an option set from converted titles and values
+    static OptionSetPtr make(std::vector<QString> &&titles, std::vector<Pothos::Object> &&values);
+
+    size_t size(void) const
+    {
+        return _titles.size();
+    }
+
+    const QString &title(const size_t row) const
+    {
+        return _titles[row];
+    }
+
+    const Pothos::Object &value(const size_t row) const
+    {
+        return _values[row];
+    }
+
+    //! The row of the last option equal to the value, or -1 when not found
+    int indexOf(const Pothos::Object &value) const;
+
+    //! Does the row have the same title and value in both sets?
+    bool sameRow(const OptionSet &other, const size_t row, const size_t otherRow) const;
+
+    /*!
+     * Compare two option sets for a minimal update.
+     * \param prefix the number of leading rows that are the same in both sets
+     * \param suffix the number of trailing rows that are the same in both sets
+     */
+    static void diff(const OptionSet &oldSet, const OptionSet &newSet, size_t &prefix, size_t &suffix);
+
+private:
+    void buildIndex(void);
+    std::vector<QString> _titles;
+    std::vector<Pothos::Object> _values;
+    std::unordered_map<std::string, int> _index;
+};
+
+/*!
+ * A list model of option titles for item views and combo boxes.
+ * Changing the option set only inserts, removes, or updates the rows that differ,
+ * so the view keeps its current row and does not rebuild unchanged items.
+ */
+class OptionListModel : public QAbstractListModel
+{
+public:
+    OptionListModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const;
+
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const;
+
+    //! Replace the options with a minimal update of the rows
+    void setOptions(const OptionSetPtr &options);
+
+    const OptionSetPtr &options(void) const
+    {
+        return _options;
+    }
+
+private:
+    OptionSetPtr _options;
+};
@@ -0,0 +1,151 @@
+// Copyright (c) 2026 agent
+// SPDX-License-Identifier: BSL-1.0
+
+#include "OptionSearch.hpp"
+#include <Pothos/Testing.hpp>
+#include <algorithm> //sort, unique, lower_bound, upper_bound
+
+/***********************************************************************
+ * Search index
+ **********************************************************************/
+OptionSearchIndex::OptionSearchIndex(const OptionSet &options):
+    _numRows(options.size())
+{
+    //join the titles with a zero separator, which sorts before every character
+    std::vector<int> rowOfPos;
+    for (size_t row = 0; row < options.size(); row++)
+    {
+        const auto title = options.title(row).toCaseFolded();
+        for (int i = 0; i < title.size(); i++)
+        {
+            if (title[i].unicode() == 0) continue;
+            _text += title[i];
+            rowOfPos.push_back(int(row));
+        }
+        _text += QChar(0);
+        rowOfPos.push_back(-1);
+    }
+
+    const ushort *text = _text.utf16();
+    for (int pos = 0; pos < _text.size(); pos++)
+    {
+        if (text[pos] != 0) _suffixes.push_back(pos);
+    }
+
+    //suffixes are compared up to the end of their title
+    std::sort(_suffixes.begin(), _suffixes.end(), [text](const int a, const int b)
+    {
+        const ushort *pa = text+a, *pb = text+b;
+        while (*pa != 0 and *pa == *pb) {pa++; pb++;}
+        return *pa < *pb;
+    });
+
+    _suffixRows.reserve(_suffixes.size());
+    for (const auto pos : _suffixes) _suffixRows.push_back(rowOfPos[pos]);
+}
+
+int OptionSearchIndex::comparePrefix(const int pos, const ushort *query, const int length) const
+{
+    const ushort *text = _text.utf16()+pos;
+    for (int i = 0; i < length; i++)
+    {
+        if (text[i] != query[i]) return (text[i] < query[i])? -1 : +1;
+    }
+    return 0;
+}
+
+std::vector<int> OptionSearchIndex::find(const QString &text) const
+{
+    std::vector<int> rows;
+    auto folded = text.toCaseFolded();
+    folded.remove(QChar(0));
+    if (folded.isEmpty())
+    {
+        rows.resize(_numRows);
+        for (size_t row = 0; row < _numRows; row++) rows[row] = int(row);
+        return rows;
+    }
+
+    //the range of suffixes that start with the query
+    const ushort *query = folded.utf16();
+    const int length = folded.size();
+    const auto first = std::lower_bound(_suffixes.begin(), _suffixes.end(), 0, [&](const int pos, const int)
+    {
+        return this->comparePrefix(pos, query, length) < 0;
+    });
+    const auto last = std::upper_bound(first, _suffixes.end(), 0, [&](const int, const int pos)
+    {
+        return this->comparePrefix(pos, query, length) > 0;
+    });
+
+    //a title can match at several positions, keep each row once,
+    //sorting only the matches keeps the cost independent of the list size
+    rows.reserve(size_t(last-first));
+    for (auto it = first; it != last; ++it) rows.push_back(_suffixRows[it-_suffixes.begin()]);
+    std::sort(rows.begin(), rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+    return rows;
+}
+
+/***********************************************************************
+ * Filter model
+ **********************************************************************/
+OptionFilterModel::OptionFilterModel(QObject *parent):
+    QAbstractListModel(parent),
+    _options(std::make_shared<OptionSet>())
+{
+    return;
+}
+
+int OptionFilterModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid()) return 0;
+    return int(_rows.size());
+}
+
+QVariant OptionFilterModel::data(const QModelIndex &index, int role) const
+{
+    if (not index.isValid() or size_t(index.row()) >= _rows.size()) return QVariant();
+    if (role == Qt::DisplayRole or role == Qt::EditRole) return _options->title(_rows[index.row()]);
+    return QVariant();
+}
+
+void OptionFilterModel::setRows(const OptionSetPtr &options, std::vector<int> &&rows)
+{
+    this->beginResetModel();
+    _options = options;
+    _rows = std::move(rows);
+    this->endResetModel();
+}
+
+int OptionFilterModel::sourceRow(const int index) const
+{
+    if (index < 0 or size_t(index) >= _rows.size()) return -1;
+    return _rows[index];
+}
+
+int OptionFilterModel::indexOfRow(const int row) const
+{
+    //the rows are in ascending order
+    const auto it = std::lower_bound(_rows.begin(), _rows.end(), row);
+    if (it == _rows.end() or *it != row) return -1;
+    return int(it - _rows.begin());
+}
+
+/***********************************************************************
+ * Check substring matches against the titles
+ **********************************************************************/
+POTHOS_TEST_BLOCK("/widgets/tests", test_option_search_index)
+{
+    std::vector<QString> titles{"Alpha 915 MHz", "Beta 2.4 GHz", "gamma 915 khz", "Delta"};
+    const auto options = OptionSet::make(std::move(titles), std::vector<Pothos::Object>(4));
+    const OptionSearchIndex index(*options);
+
+    POTHOS_TEST_EQUAL(index.find("").size(), size_t(4));
+    POTHOS_TEST_TRUE(index.find("915") == std::vector<int>({0, 2}));
+    POTHOS_TEST_TRUE(index.find("HZ") == std::vector<int>({0, 1, 2}));
+    POTHOS_TEST_TRUE(index.find("ta") == std::vector<int>({1, 3}));
+    POTHOS_TEST_TRUE(index.find("delta") == std::vector<int>({3}));
+    POTHOS_TEST_TRUE(index.find("alpha beta").empty());
+    POTHOS_TEST_TRUE(index.find("zzz").empty());
+}
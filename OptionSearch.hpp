@@ -0,0 +1,65 @@
+// Copyright (c) 2026 agent
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include "OptionModel.hpp"
+#include <QAbstractListModel>
+#include <QString>
+#include <memory>
+#include <vector>
+
+class OptionSearchIndex;
+typedef std::shared_ptr<const OptionSearchIndex> OptionSearchIndexPtr;
+
+/*!
+ * A case insensitive substring index over the titles of an option set.
+ *
+ * The case folded titles are joined into one text with a separator,
+ * and every suffix of the text is sorted once when the index is built.
+ * A search is then a binary search for the range of suffixes that start with the query,
+ * so the cost depends on the query length and the number of matches, not on the list size.
+ * An empty query matches every row, so it is the one search that costs the list size.
+ */
+class OptionSearchIndex
+{
+public:
+    OptionSearchIndex(const OptionSet &options);
+
+    //! The rows with a title that contains the text in ascending order, or every row for empty text
+    std::vector<int> find(const QString &text) const;
+
+private:
+    int comparePrefix(const int pos, const ushort *query, const int length) const;
+
+    size_t _numRows;
+    QString _text;
+    std::vector<int> _suffixes; //suffix start positions in sorted order
+    std::vector<int> _suffixRows; //the row of each sorted suffix
+};
+
+/*!
+ * A list model of a filtered subset of the option rows.
+ * Setting the rows resets the model, which costs the number of shown rows.
+ */
+class OptionFilterModel : public QAbstractListModel
+{
+public:
+    OptionFilterModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const;
+
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const;
+
+    //! Show only the given rows of the options
+    void setRows(const OptionSetPtr &options, std::vector<int> &&rows);
+
+    //! The option row for a row of this model, or -1
+    int sourceRow(const int index) const;
+
+    //! The row of this model that shows an option row, or -1 when filtered out
+    int indexOfRow(const int row) const;
+
+private:
+    OptionSetPtr _options;
+    std::vector<int> _rows;
+};
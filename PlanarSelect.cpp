@@ -2,6 +2,9 @@
 // SPDX-License-Identifier: BSL-1.0
 
 #include <Pothos/Framework.hpp>
+#include "StreamRamp.hpp"
+#include "ValueMirror.hpp"
+#include "EmitThrottle.hpp"
 #include <QGroupBox>
 #include <QGraphicsView>
 #include <QGraphicsScene>
@@ -10,6 +13,7 @@
 #include <QResizeEvent>
 #include <QMouseEvent>
 #include <QPainter>
+#include <QTimer>
 #include <vector>
 #include <complex>
 #include <iostream>
@@ -136,6 +140,7 @@ public slots:
 
 signals:
     void positionChanged(const QPointF &);
+    void dragFinished(void);
 
 private slots:
     void handleCrossHairsPointChanged(const QPointF &pos)
@@ -166,6 +171,12 @@ protected:
         }
     }
 
+    void mouseReleaseEvent(QMouseEvent *mouseEvent)
+    {
+        QGraphicsView::mouseReleaseEvent(mouseEvent);
+        if (mouseEvent->button() == Qt::LeftButton) emit this->dragFinished();
+    }
+
 private:
 
     QPointF scenePosToRelPos(const QPointF &scenePos) const
@@ -188,9 +199,19 @@ private:
  * as a two dimensional vector of doubles through the "valueChanged" signal,
  * and as a complex number through the "complexValueChanged" signal.
  *
+ * The planar select can optionally output its value as a stream of complex samples.
+ * The stream follows the crosshair as it moves, regardless of the max rate.
+ *
  * |category /Widgets
  * |keywords 2d plane cartesian complex
  *
+ * |param portMode [Port Mode] Enable an optional stream output port.
+ * The stream source outputs the current value continuously as complex float64 samples.
+ * |default "NONE"
+ * |option [None] "NONE"
+ * |option [Stream Source] "SOURCE"
+ * |preview disable
+ *
  * |param title The name of the value displayed by this widget
  * |default "My Coordinate"
  * |widget StringEntry()
@@ -204,26 +225,43 @@ private:
  * |param maximum The largest X and Y bounds of the selection.
  * |default [1.0, 1.0]
  *
+ * |param maxRate [Max Rate] The maximum number of value changes emitted per second while dragging.
+ * Changes in between are coalesced, and the last value is always emitted when the crosshair is released.
+ * Use 0 for no limit.
+ * |units Hz
+ * |default 0.0
+ * |preview disable
+ *
+ * |param rampLength [Ramp Length] The number of samples to ramp over when the value changes.
+ * The stream output moves linearly from the old value to the new value
+ * so that changes do not cause discontinuities. Use 0 to change immediately.
+ * |units samples
+ * |default 0
+ * |preview when(enum=portMode, "SOURCE")
+ *
  * |mode graphWidget
- * |factory /widgets/planar_select()
+ * |factory /widgets/planar_select(portMode)
  * |setter setTitle(title)
  * |setter setMinimum(minimum)
  * |setter setMaximum(maximum)
  * |setter setValue(value)
+ * |setter setMaxRate(maxRate)
+ * |setter setRampLength(rampLength)
  **********************************************************************/
 class PlanarSelect : public QGroupBox, public Pothos::Block
 {
     Q_OBJECT
 public:
 
-    static Block *make(void)
+    static Block *make(const std::string &portMode)
     {
-        return new PlanarSelect();
+        return new PlanarSelect(portMode);
     }
 
-    PlanarSelect(void):
+    PlanarSelect(const std::string &portMode):
         _view(new PlanarSelectGraphicsView(this)),
-        _layout(new QHBoxLayout(this))
+        _layout(new QHBoxLayout(this)),
+        _emitTimer(new QTimer(this))
     {
         this->setStyleSheet("QGroupBox {font-weight: bold;}");
         this->registerCall(this, POTHOS_FCN_TUPLE(PlanarSelect, widget));
@@ -232,13 +270,20 @@ public:
         this->registerCall(this, POTHOS_FCN_TUPLE(PlanarSelect, setValue));
         this->registerCall(this, POTHOS_FCN_TUPLE(PlanarSelect, setMinimum));
         this->registerCall(this, POTHOS_FCN_TUPLE(PlanarSelect, setMaximum));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PlanarSelect, setMaxRate));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PlanarSelect, setRampLength));
         this->registerSignal("valueChanged");
         this->registerSignal("complexValueChanged");
+        if (portMode == "SOURCE") this->setupOutput(0, "complex_float64");
+        else if (portMode != "NONE") throw Pothos::InvalidArgumentException("PlanarSelect("+portMode+")", "unknown port mode");
 
         _layout->addWidget(_view);
         _layout->setContentsMargins(QMargins());
         _layout->setSpacing(0);
         connect(_view, &PlanarSelectGraphicsView::positionChanged, this, &PlanarSelect::handlePositionChanged);
+        connect(_view, &PlanarSelectGraphicsView::dragFinished, this, &PlanarSelect::handleDragFinished);
+        _emitTimer->setSingleShot(true);
+        connect(_emitTimer, &QTimer::timeout, this, &PlanarSelect::handleEmitTimeout);
     }
 
     QWidget *widget(void)
@@ -253,15 +298,16 @@ public:
 
     std::vector<double> value(void) const
     {
+        const auto value = _valueMirror.load();
         std::vector<double> vals(2);
-        vals[0] = _value.x();
-        vals[1] = _value.y();
+        vals[0] = value.real();
+        vals[1] = value.imag();
         return vals;
     }
 
     std::complex<double> complexValue(void) const
     {
-        return std::complex<double>(_value.x(), _value.y());
+        return _valueMirror.load();
     }
 
     void setValue(const std::vector<double> &value)
@@ -271,6 +317,18 @@ public:
         const auto pos = _value - _minimum;
         const auto range = _maximum - _minimum;
         const QPointF viewPos(pos.x()/range.x(), pos.y()/range.y());
+
+        //publish the value clipped like the view clips its position, activate() may run before the queued slot
+        const QPointF clipped(
+            std::max(std::min(viewPos.x(), 1.0), 0.0),
+            std::max(std::min(viewPos.y(), 1.0), 0.0));
+        const std::complex<double> published(
+            _minimum.x()+clipped.x()*range.x(),
+            _minimum.y()+clipped.y()*range.y());
+        _valueMirror.store(published);
+
+        //the view does not signal a position within the same pixel, so feed the stream here
+        _stream.setValue(published);
         QMetaObject::invokeMethod(_view, "setPosition", Qt::QueuedConnection, Q_ARG(QPointF, viewPos));
     }
 
@@ -286,12 +344,30 @@ public:
         _maximum = QPointF(maximum[0], maximum[1]);
     }
 
+    void setMaxRate(const double rate)
+    {
+        if (rate < 0.0) throw Pothos::RangeException("PlanarSelect::setMaxRate()", "rate must be non-negative");
+        QMetaObject::invokeMethod(this, "handleSetMaxRate", Qt::QueuedConnection, Q_ARG(double, rate));
+    }
+
+    void setRampLength(const size_t length)
+    {
+        _stream.setRampLength(length);
+    }
+
     void activate(void)
     {
         //emit current value when design becomes active
+        _stream.setValue(this->complexValue());
         this->emitValuesChanged();
     }
 
+    void work(void)
+    {
+        if (this->outputs().empty()) return;
+        _stream.work(this->output(0));
+    }
+
 public slots:
 
     QVariant saveState(void) const
@@ -301,8 +377,8 @@ public slots:
 
     void restoreState(const QVariant &state)
     {
-        _value = state.toPointF();
-        this->setValue(this->value());
+        const auto value = state.toPointF();
+        this->setValue(std::vector<double>{value.x(), value.y()});
     }
 
 private slots:
@@ -311,7 +387,29 @@ private slots:
     {
         const auto range = _maximum - _minimum;
         _value = QPointF(pos.x()*range.x(), pos.y()*range.y()) + _minimum;
-        this->emitValuesChanged();
+        const std::complex<double> value(_value.x(), _value.y());
+        _valueMirror.store(value);
+        _stream.setValue(value);
+
+        //emit now when outside of the rate limit, otherwise coalesce into one later emit
+        if (_throttle.update()) this->emitNow();
+        else if (not _emitTimer->isActive()) _emitTimer->start(_throttle.delayMs());
+    }
+
+    void handleDragFinished(void)
+    {
+        //the released position is never left behind in the rate limit
+        if (_throttle.flush()) this->emitNow();
+    }
+
+    void handleEmitTimeout(void)
+    {
+        if (_throttle.flush()) this->emitNow();
+    }
+
+    void handleSetMaxRate(const double rate)
+    {
+        _throttle.setMaxRate(rate);
     }
 
     void handleSetTitle(const QString &title)
@@ -328,10 +426,17 @@ protected:
 
 private:
 
+    void emitNow(void)
+    {
+        _emitTimer->stop();
+        this->emitValuesChanged();
+    }
+
     void emitValuesChanged(void)
     {
-        this->emitSignal("valueChanged", this->value());
-        this->emitSignal("complexValueChanged", this->complexValue());
+        const auto value = this->complexValue();
+        this->emitSignal("valueChanged", std::vector<double>{value.real(), value.imag()});
+        this->emitSignal("complexValueChanged", value);
     }
 
     QPointF _minimum;
@@ -339,6 +444,10 @@ private:
     QPointF _value;
     PlanarSelectGraphicsView *_view;
     QHBoxLayout *_layout;
+    StreamRamp<std::complex<double>> _stream;
+    ValueMirror<std::complex<double>> _valueMirror;
+    QTimer *_emitTimer;
+    EmitThrottle _throttle;
 };
 
 static Pothos::BlockRegistry registerPlanarSelect(
@@ -3,11 +3,15 @@
 
 #include <Pothos/Framework.hpp>
 #include <Pothos/Object/Containers.hpp>
+#include "ControlLabeler.hpp"
+#include "OptionModel.hpp"
+#include "OptionFile.hpp"
 #include <QGroupBox>
 #include <QRadioButton>
 #include <QBoxLayout>
 #include <QMouseEvent>
-#include <map>
+#include <vector>
+#include <mutex>
 
 /***********************************************************************
  * |PothosDoc Radio Group
@@ -18,6 +22,15 @@
  * |category /Widgets
  * |keywords radio buttons
  *
+ * |param portMode [Port Mode] Enable an optional stream passthrough.
+ * The passthrough forwards an input stream to the output without copying,
+ * and each selection change is marked by a "valueChanged" label carrying the new value,
+ * at the first sample of the next forwarded buffer.
+ * |default "NONE"
+ * |option [None] "NONE"
+ * |option [Stream Passthrough] "PASSTHROUGH"
+ * |preview disable
+ *
  * |param title The name of the value displayed by this widget
  * |default "My Radio Value"
  * |widget StringEntry()
@@ -40,11 +53,22 @@
  *
  * |default [["Opt0", 42], ["Opt1", "xyz"]]
  *
+ * |param optionsFile [Options File] Load the options from a local file instead of the options list.
+ * A CSV file has one title,value record per line, double quote fields that contain commas.
+ * A JSON lines file (.jsonl) has one ["title", value] array per line.
+ * Unquoted numbers and true/false are loaded as values of that type, everything else as strings.
+ * The file is checked again when the design is activated, and only reloaded when it changed.
+ * Leave empty to use the options list.
+ * |default ""
+ * |widget FileEntry(mode=open)
+ * |preview valid
+ *
  * |mode graphWidget
- * |factory /widgets/radio_group()
+ * |factory /widgets/radio_group(portMode)
  * |setter setTitle(title)
  * |setter setDirection(direction)
  * |setter setOptions(options)
+ * |setter setOptionsFile(optionsFile)
  * |setter setValue(value)
  **********************************************************************/
 class RadioGroup : public QGroupBox, public Pothos::Block
@@ -52,13 +76,17 @@ class RadioGroup : public QGroupBox, public Pothos::Block
     Q_OBJECT
 public:
 
-    static Block *make(void)
+    static Block *make(const std::string &portMode)
     {
-        return new RadioGroup();
+        return new RadioGroup(portMode);
     }
 
-    RadioGroup(void):
-        _layout(new QBoxLayout(QBoxLayout::TopToBottom, this))
+    RadioGroup(const std::string &portMode):
+        _layout(new QBoxLayout(QBoxLayout::TopToBottom, this)),
+        _options(std::make_shared<OptionSet>()),
+        _listOptions(_options),
+        _labeler("valueChanged"),
+        _settingOptions(false)
     {
         this->setStyleSheet("QGroupBox {font-weight: bold;}");
         this->registerCall(this, POTHOS_FCN_TUPLE(RadioGroup, widget));
@@ -67,10 +95,18 @@ public:
         this->registerCall(this, POTHOS_FCN_TUPLE(RadioGroup, setDirection));
         this->registerCall(this, POTHOS_FCN_TUPLE(RadioGroup, setValue));
         this->registerCall(this, POTHOS_FCN_TUPLE(RadioGroup, setOptions));
+        this->registerCall(this, POTHOS_FCN_TUPLE(RadioGroup, setOptionsFile));
         this->registerSignal("valueChanged");
 
         qRegisterMetaType<Pothos::Object>("Pothos::Object");
-        qRegisterMetaType<Pothos::ObjectVector>("Pothos::ObjectVector");
+        qRegisterMetaType<OptionSetPtr>("OptionSetPtr");
+
+        if (portMode == "PASSTHROUGH")
+        {
+            this->setupInput(0);
+            this->setupOutput(0);
+        }
+        else if (portMode != "NONE") throw Pothos::InvalidArgumentException("RadioGroup("+portMode+")", "unknown port mode");
     }
 
     QWidget *widget(void)
@@ -80,8 +116,18 @@ public:
 
     void activate(void)
     {
+        //pick up changes to the options file since it was last loaded
+        this->loadOptionsFile();
+
         //emit current value when design becomes active
-        this->handleRadioChanged(true);
+        _labeler.setValue(this->value());
+        this->emitSignal("valueChanged", this->value());
+    }
+
+    void work(void)
+    {
+        if (this->inputs().empty()) return;
+        _labeler.work(this->input(0), this->output(0));
     }
 
     void setTitle(const QString &title)
@@ -99,11 +145,8 @@ public:
 
     Pothos::Object value(void) const
     {
-        for (auto pair : _radioToOption)
-        {
-            if (pair.first->isChecked()) return pair.second;
-        }
-        return Pothos::Object();
+        std::lock_guard<std::mutex> lock(_valueMutex);
+        return _value;
     }
 
     void setValue(const Pothos::Object &value)
@@ -113,24 +156,27 @@ public:
 
     void setOptions(const Pothos::ObjectVector &options)
     {
-        //validate first
-        for (const auto &option : options)
-        {
-            if (not option.canConvert(typeid(Pothos::ObjectVector))) throw Pothos::DataFormatException("RadioGroup::setOptions()", "entry is not ObjectVector");
-            auto optPair = option.convert<Pothos::ObjectVector>();
-            if (optPair.size() != 2) throw Pothos::DataFormatException("RadioGroup::setOptions()", "entry must be ObjectVector of size == 2");
-            if (not optPair.at(0).canConvert(typeid(QString))) throw Pothos::DataFormatException("RadioGroup::setOptions()", "entry[0] must be a string");
-        }
-        QMetaObject::invokeMethod(this, "__setOptions", Qt::QueuedConnection, Q_ARG(Pothos::ObjectVector, options));
+        //validate and convert once, the GUI thread shares the immutable result
+        _listOptions = OptionSet::make(options, "RadioGroup::setOptions()");
+        if (_optionsPath.isEmpty()) this->postOptions(_listOptions);
+    }
+
+    void setOptionsFile(const QString &path)
+    {
+        //the options file takes the place of the options list until it is cleared
+        const bool hadFile = not _optionsPath.isEmpty();
+        _optionsPath = path;
+        this->loadOptionsFile();
+        if (hadFile and path.isEmpty()) this->postOptions(_listOptions);
     }
 
 public slots:
 
     QVariant saveState(void) const
     {
-        for (size_t i = 0; i < _radioToOption.size(); i++)
+        for (size_t i = 0; i < _radios.size(); i++)
         {
-            if (_radioToOption[i].first->isChecked()) return int(i);
+            if (_radios[i]->isChecked()) return int(i);
         }
         return QVariant();
     }
@@ -138,8 +184,8 @@ public slots:
     void restoreState(const QVariant &state)
     {
         const size_t index = state.toUInt();
-        if (index >= _radioToOption.size()) return;
-        __setValue(_radioToOption[index].second);
+        if (index >= _radios.size()) return;
+        _radios[index]->setChecked(true);
     }
 
 protected:
@@ -151,37 +197,54 @@ protected:
 
 private slots:
 
-    void __setOptions(const Pothos::ObjectVector &options)
+    void __setOptions(const OptionSetPtr &options)
     {
         auto oldValue = this->value();
-        this->clear();
+        _options = options;
 
-        for (const auto &option : options)
+        //toggles caused by the new options are compared with the old value below
+        _settingOptions = true;
+
+        //reuse the existing buttons, only the difference in count is created or deleted
+        while (_radios.size() > options->size())
         {
-            auto optPair = option.convert<Pothos::ObjectVector>();
-            auto title = optPair.at(0).convert<QString>();
-            auto value = optPair.at(1);
-            auto radio = new QRadioButton(title, this);
-            connect(radio, &QRadioButton::toggled, this, &RadioGroup::handleRadioChanged);
-            _radioToOption.push_back(std::make_pair(radio, value));
-            _layout->addWidget(radio);
+            delete _radios.back();
+            _radios.pop_back();
+        }
+        for (size_t row = 0; row < options->size(); row++)
+        {
+            if (row == _radios.size())
+            {
+                auto radio = new QRadioButton(this);
+                connect(radio, &QRadioButton::toggled, this, [this, row](const bool toggled){this->handleRadioChanged(row, toggled);});
+                _radios.push_back(radio);
+                _layout->addWidget(radio);
+            }
+            if (_radios[row]->text() != options->title(row)) _radios[row]->setText(options->title(row));
         }
 
-        this->setValue(oldValue);
-    }
-
-    void __setValue(const Pothos::Object &value)
-    {
-        for (auto pair : _radioToOption)
+        //a reused button may now stand for a different value
+        const int index = options->indexOf(oldValue);
+        if (index >= 0) _radios[index]->setChecked(true);
+        Pothos::Object checked;
+        for (size_t row = 0; row < _radios.size(); row++)
         {
-            pair.first->setChecked(pair.second.equals(value));
+            if (_radios[row]->isChecked()) checked = options->value(row);
         }
+        _settingOptions = false;
+        this->storeValue(checked);
+
+        //only report the value when it changed, not when it moved to another row
+        if (oldValue and checked and oldValue.equals(checked)) return;
+        if (not oldValue and not checked) return;
+        _labeler.setValue(this->value());
+        this->emitSignal("valueChanged", this->value());
     }
 
-    void handleRadioChanged(const bool toggled)
+    void __setValue(const Pothos::Object &value)
     {
-        if (not toggled) return;
-        this->emitSignal("valueChanged", this->value());
+        const int index = _options->indexOf(value);
+        if (index >= 0) _radios[index]->setChecked(true);
     }
 
     void handleSetTitle(const QString &title)
@@ -191,14 +254,43 @@ private slots:
 
 private:
 
-    void clear(void)
+    void postOptions(const OptionSetPtr &optionSet)
+    {
+        QMetaObject::invokeMethod(this, "__setOptions", Qt::QueuedConnection, Q_ARG(OptionSetPtr, optionSet));
+    }
+
+    void loadOptionsFile(void)
+    {
+        const auto optionSet = _optionFile.load(_optionsPath, "RadioGroup::setOptionsFile()");
+        if (optionSet) this->postOptions(optionSet);
+    }
+
+    void storeValue(const Pothos::Object &value)
     {
-        for (auto pair : _radioToOption) delete pair.first;
-        _radioToOption.clear();
+        std::lock_guard<std::mutex> lock(_valueMutex);
+        _value = value;
+    }
+
+    void handleRadioChanged(const size_t row, const bool toggled)
+    {
+        if (not toggled or _settingOptions) return;
+        this->storeValue(_options->value(row));
+        _labeler.setValue(this->value());
+        this->emitSignal("valueChanged", this->value());
     }
 
     QBoxLayout *_layout;
-    std::vector<std::pair<QRadioButton *, Pothos::Object>> _radioToOption;
+    std::vector<QRadioButton *> _radios;
+    OptionSetPtr _options;
+    OptionSetPtr _listOptions;
+    QString _optionsPath;
+    OptionFile _optionFile;
+    ControlLabeler _labeler;
+    bool _settingOptions;
+
+    //the published value for the getter
+    mutable std::mutex _valueMutex;
+    Pothos::Object _value;
 };
 
 static Pothos::BlockRegistry registerRadioGroup(
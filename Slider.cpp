@@ -3,19 +3,38 @@
 
 #include <Pothos/Framework.hpp>
 #include "MyDoubleSlider.hpp"
+#include "StreamRamp.hpp"
+#include "ControlLabeler.hpp"
+#include "ValueMirror.hpp"
 #include <QVariant>
 #include <QGroupBox>
 #include <QVBoxLayout>
 #include <QMouseEvent>
+#include <algorithm> //min/max
+#include <atomic>
 
 /***********************************************************************
  * |PothosDoc Slider
  *
  * A slider widget for graphical control of an integer value.
  *
+ * The slider can optionally output its value as a stream of samples.
+ * The stream follows the slider as it moves, regardless of the tracking mode.
+ *
  * |category /Widgets
  * |keywords slider
  *
+ * |param portMode [Port Mode] Enable optional stream ports.
+ * The stream source outputs the current value continuously as float64 samples.
+ * The stream passthrough forwards an input stream to the output without copying,
+ * and each emitted value change is marked by a "valueChanged" label carrying the new value,
+ * at the first sample of the next forwarded buffer.
+ * |default "NONE"
+ * |option [None] "NONE"
+ * |option [Stream Source] "SOURCE"
+ * |option [Stream Passthrough] "PASSTHROUGH"
+ * |preview disable
+ *
  * |param title The name of the value displayed by this widget
  * |default "My Slider Value"
  * |widget StringEntry()
@@ -38,26 +57,62 @@
  * |param step [Step Size] The increment between discrete values.
  * |default 0.01
  *
+ * |param tracking [Tracking] When value changes are emitted while the slider is dragged.
+ * Continuous emits as the slider moves, limited by the max rate.
+ * On release emits once when the slider is released.
+ * On settle emits once the slider has stopped moving for the settle time.
+ * |default "CONTINUOUS"
+ * |option [Continuous] "CONTINUOUS"
+ * |option [On Release] "RELEASE"
+ * |option [On Settle] "SETTLE"
+ * |preview disable
+ *
+ * |param maxRate [Max Rate] The maximum number of value changes emitted per second in continuous mode.
+ * Use 0 for no limit.
+ * |units Hz
+ * |default 0.0
+ * |preview when(enum=tracking, "CONTINUOUS")
+ *
+ * |param settleTime [Settle Time] How long the slider must be still before the value is emitted in settle mode.
+ * |units ms
+ * |default 100
+ * |preview when(enum=tracking, "SETTLE")
+ *
+ * |param rampLength [Ramp Length] The number of samples to ramp over when the value changes.
+ * The stream output moves linearly from the old value to the new value
+ * so that changes do not cause discontinuities. Use 0 to change immediately.
+ * |units samples
+ * |default 0
+ * |preview when(enum=portMode, "SOURCE")
+ *
  * |mode graphWidget
- * |factory /widgets/slider(orientation)
+ * |factory /widgets/slider(orientation, portMode)
  * |setter setTitle(title)
  * |setter setMinimum(minimum)
  * |setter setMaximum(maximum)
  * |setter setSingleStep(step)
  * |setter setValue(value)
+ * |setter setTracking(tracking)
+ * |setter setMaxRate(maxRate)
+ * |setter setSettleTime(settleTime)
+ * |setter setRampLength(rampLength)
  **********************************************************************/
 class Slider : public QGroupBox, public Pothos::Block
 {
     Q_OBJECT
 public:
 
-    static Block *make(const std::string &orientation)
+    static Block *make(const std::string &orientation, const std::string &portMode)
     {
-        return new Slider(orientation);
+        return new Slider(orientation, portMode);
     }
 
-    Slider(const std::string &orientation):
-        _slider(new MyDoubleSlider((orientation == "Horizontal")? Qt::Horizontal : Qt::Vertical))
+    Slider(const std::string &orientation, const std::string &portMode):
+        _slider(new MyDoubleSlider((orientation == "Horizontal")? Qt::Horizontal : Qt::Vertical)),
+        _labeler("valueChanged"),
+        _passthrough(portMode == "PASSTHROUGH"),
+        _minimum(0.0),
+        _maximum(100.0)
     {
         auto layout = new QVBoxLayout(this);
         layout->setContentsMargins(QMargins());
@@ -71,8 +126,20 @@ public:
         this->registerCall(this, POTHOS_FCN_TUPLE(Slider, setMinimum));
         this->registerCall(this, POTHOS_FCN_TUPLE(Slider, setMaximum));
         this->registerCall(this, POTHOS_FCN_TUPLE(Slider, setSingleStep));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Slider, setTracking));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Slider, setMaxRate));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Slider, setSettleTime));
+        this->registerCall(this, POTHOS_FCN_TUPLE(Slider, setRampLength));
         this->registerSignal("valueChanged");
         connect(_slider, &MyDoubleSlider::valueChanged, this, &Slider::handleValueChanged);
+        connect(_slider, &QSlider::valueChanged, this, &Slider::handleSliderMoved);
+        if (portMode == "SOURCE") this->setupOutput(0, "float64");
+        else if (portMode == "PASSTHROUGH")
+        {
+            this->setupInput(0);
+            this->setupOutput(0);
+        }
+        else if (portMode != "NONE") throw Pothos::InvalidArgumentException("Slider("+portMode+")", "unknown port mode");
     }
 
     QWidget *widget(void)
@@ -87,33 +154,73 @@ public:
 
     double value(void) const
     {
-        return _slider->value();
+        return _value.load();
     }
 
     void setValue(const double value)
     {
-        _slider->setValue(value);
+        //publish the clipped value now, activate() may run before the queued slot
+        const auto clipped = std::max(std::min(value, _maximum.load()), _minimum.load());
+        _value.store(clipped);
+
+        //the slider does not signal a value within its current step, so feed the stream here
+        _stream.setValue(clipped);
+
+        //the slider's emission timer belongs to the GUI thread, forward to the slider slot
+        QMetaObject::invokeMethod(_slider, "setValue", Qt::QueuedConnection, Q_ARG(double, value));
     }
 
     void setMinimum(const double value)
     {
-        _slider->setMinimum(value);
+        _minimum = value;
+        QMetaObject::invokeMethod(_slider, "setMinimum", Qt::QueuedConnection, Q_ARG(double, value));
     }
 
     void setMaximum(const double value)
     {
-        _slider->setMaximum(value);
+        _maximum = value;
+        QMetaObject::invokeMethod(_slider, "setMaximum", Qt::QueuedConnection, Q_ARG(double, value));
     }
 
     void setSingleStep(const double value)
     {
-        _slider->setSingleStep(value);
+        QMetaObject::invokeMethod(_slider, "setSingleStep", Qt::QueuedConnection, Q_ARG(double, value));
+    }
+
+    void setTracking(const QString &mode)
+    {
+        if (mode != "CONTINUOUS" and mode != "RELEASE" and mode != "SETTLE") throw Pothos::InvalidArgumentException("Slider::setTracking("+mode.toStdString()+")", "unknown tracking mode");
+        QMetaObject::invokeMethod(_slider, "setTrackingMode", Qt::QueuedConnection, Q_ARG(QString, mode));
+    }
+
+    void setMaxRate(const double rate)
+    {
+        QMetaObject::invokeMethod(_slider, "setMaxRate", Qt::QueuedConnection, Q_ARG(double, rate));
+    }
+
+    void setSettleTime(const int ms)
+    {
+        QMetaObject::invokeMethod(_slider, "setSettleTime", Qt::QueuedConnection, Q_ARG(int, ms));
+    }
+
+    void setRampLength(const size_t length)
+    {
+        _stream.setRampLength(length);
     }
 
     void activate(void)
     {
         //emit current value when design becomes active
         this->emitSignal("valueChanged", this->value());
+        _stream.setValue(this->value());
+        _labeler.setValue(Pothos::Object(this->value()));
+    }
+
+    void work(void)
+    {
+        if (this->outputs().empty()) return;
+        if (_passthrough) _labeler.work(this->input(0), this->output(0));
+        else _stream.work(this->output(0));
     }
 
 public slots:
@@ -131,9 +238,16 @@ public slots:
 private slots:
     void handleValueChanged(const double value)
     {
+        _value.store(value);
+        _labeler.setValue(Pothos::Object(value));
         this->emitSignal("valueChanged", value);
     }
 
+    void handleSliderMoved(const int)
+    {
+        _stream.setValue(_slider->value());
+    }
+
     void handleSetTitle(const QString &title)
     {
         QGroupBox::setTitle(title);
@@ -148,6 +262,14 @@ protected:
 
 private:
     MyDoubleSlider *_slider;
+    StreamRamp<double> _stream;
+    ControlLabeler _labeler;
+    bool _passthrough;
+    ValueMirror<double> _value;
+
+    //the range requested by the setters, for clipping the published value
+    std::atomic<double> _minimum;
+    std::atomic<double> _maximum;
 };
 
 static Pothos::BlockRegistry registerSlider(
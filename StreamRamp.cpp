@@ -0,0 +1,127 @@
+// Copyright (c) 2026 agent
+// SPDX-License-Identifier: BSL-1.0
+
+#include "StreamRamp.hpp"
+#include <Pothos/Testing.hpp>
+#include <algorithm> //min, fill
+#include <complex>
+
+template <typename Type>
+StreamRamp<Type>::StreamRamp(void):
+    _target(),
+    _changed(false),
+    _rampLength(0),
+    _primed(false),
+    _current(),
+    _end(),
+    _start(),
+    _step(),
+    _rampIndex(0),
+    _rampRemaining(0)
+{
+    return;
+}
+
+template <typename Type>
+void StreamRamp<Type>::setRampLength(const size_t length)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _rampLength = length;
+}
+
+template <typename Type>
+void StreamRamp<Type>::setValue(const Type &value)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _target = value;
+    _changed = true;
+}
+
+template <typename Type>
+void StreamRamp<Type>::work(Pothos::OutputPort *port)
+{
+    const size_t num = port->elements();
+    if (num == 0) return;
+    this->fill(port->buffer().template as<Type *>(), num);
+    port->produce(num);
+}
+
+template <typename Type>
+void StreamRamp<Type>::fill(Type *out, const size_t num)
+{
+    //start a new ramp from the current output when the value changed
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_changed)
+        {
+            _changed = false;
+            if (_primed and _rampLength != 0)
+            {
+                _start = _current;
+                _step = (_target - _current)/double(_rampLength);
+                _rampIndex = 0;
+                _rampRemaining = _rampLength;
+            }
+            else
+            {
+                _rampRemaining = 0;
+                _current = _target;
+            }
+            _primed = true;
+            _end = _target;
+        }
+    }
+
+    //the ramp and the constant fill are simple loops that the compiler vectorizes
+    size_t i = 0;
+    if (_rampRemaining != 0)
+    {
+        const size_t n = std::min(num, _rampRemaining);
+        const Type start = _start;
+        const Type step = _step;
+        const size_t index = _rampIndex+1;
+        for (; i < n; i++) out[i] = start + step*double(index+i);
+        _rampIndex += n;
+        _rampRemaining -= n;
+        //remember where to resume if the value changes again mid-ramp
+        _current = (_rampRemaining == 0)? _end : out[n-1];
+        if (_rampRemaining != 0) return;
+    }
+    std::fill(out+i, out+num, _current);
+}
+
+template class StreamRamp<double>;
+template class StreamRamp<std::complex<double>>;
+
+/***********************************************************************
+ * Check the ramp across multiple fills
+ **********************************************************************/
+POTHOS_TEST_BLOCK("/widgets/tests", test_stream_ramp)
+{
+    StreamRamp<double> ramp;
+    ramp.setRampLength(4);
+    double out[6];
+
+    //the first value is not ramped
+    ramp.setValue(1.0);
+    ramp.fill(out, 2);
+    POTHOS_TEST_EQUAL(out[0], 1.0);
+    POTHOS_TEST_EQUAL(out[1], 1.0);
+
+    //ramp over 4 samples split across two fills
+    ramp.setValue(5.0);
+    ramp.fill(out, 2);
+    POTHOS_TEST_CLOSE(out[0], 2.0, 1e-9);
+    POTHOS_TEST_CLOSE(out[1], 3.0, 1e-9);
+    ramp.fill(out, 6);
+    POTHOS_TEST_CLOSE(out[0], 4.0, 1e-9);
+    POTHOS_TEST_CLOSE(out[1], 5.0, 1e-9);
+    POTHOS_TEST_EQUAL(out[5], 5.0);
+
+    //step when the ramp is disabled
+    StreamRamp<std::complex<double>> complexRamp;
+    complexRamp.setValue(std::complex<double>(1.0, -1.0));
+    std::complex<double> complexOut[3];
+    complexRamp.fill(complexOut, 3);
+    POTHOS_TEST_TRUE(complexOut[2] == std::complex<double>(1.0, -1.0));
+}
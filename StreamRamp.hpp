@@ -0,0 +1,50 @@
+// Copyright (c) 2026 agent
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include <Pothos/Framework.hpp>
+#include <mutex>
+
+/*!
+ * Fill an output stream with a control value.
+ * When the value changes, the output ramps linearly from the current output
+ * to the new value over the ramp length, and then holds the new value.
+ * The very first value is output immediately without a ramp.
+ *
+ * setValue() and setRampLength() may be called from any thread,
+ * the changes are picked up by the next work() call on the block thread.
+ * Implemented for double and std::complex<double>.
+ */
+template <typename Type>
+class StreamRamp
+{
+public:
+    StreamRamp(void);
+
+    //! Set the number of samples to ramp over, 0 to step to new values
+    void setRampLength(const size_t length);
+
+    //! Set the value to output
+    void setValue(const Type &value);
+
+    //! Fill the available output elements and produce them
+    void work(Pothos::OutputPort *port);
+
+    //! Fill the output memory, ramping towards the latest value
+    void fill(Type *out, const size_t num);
+
+private:
+    std::mutex _mutex;
+    Type _target;
+    bool _changed;
+    size_t _rampLength;
+
+    //block thread state
+    bool _primed;
+    Type _current;
+    Type _end;
+    Type _start;
+    Type _step;
+    size_t _rampIndex;
+    size_t _rampRemaining;
+};
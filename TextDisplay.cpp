@@ -2,8 +2,376 @@
 // SPDX-License-Identifier: BSL-1.0
 
 #include <Pothos/Framework.hpp>
+#include <Pothos/Object/Containers.hpp>
+#include <Pothos/Testing.hpp>
+#include "FormatEngine.hpp"
+#include "DerivedValue.hpp"
 #include <QLabel>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QStaticText>
+#include <QPainter>
 #include <complex>
+#include <cstdint>
+#include <algorithm> //min/max
+#include <limits>
+#include <cmath>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <cstdio> //snprintf
+
+/***********************************************************************
+ * Bounded stringification of arbitrary objects
+ **********************************************************************/
+static void appendElement(std::string &out, const double value)
+{
+    char buff[32];
+    const int len = std::snprintf(buff, sizeof(buff), "%g", value);
+    out.append(buff, size_t(std::max(len, 0)));
+}
+
+static void appendElement(std::string &out, const long long value)
+{
+    out += std::to_string(value);
+}
+
+static void appendElement(std::string &out, const unsigned long long value)
+{
+    out += std::to_string(value);
+}
+
+static void appendElement(std::string &out, const std::complex<double> &value)
+{
+    appendElement(out, value.real());
+    out += '+';
+    appendElement(out, value.imag());
+    out += 'j';
+}
+
+static void appendBounded(std::string &out, const Pothos::Object &obj, const size_t maxChars);
+
+//append no more of the string than the remaining budget
+static void appendString(std::string &out, const std::string &str, const size_t maxChars)
+{
+    const size_t remaining = (out.size() <= maxChars)? maxChars+1-out.size() : 0;
+    out.append(str, 0, std::min(str.size(), remaining));
+}
+
+/*!
+ * Append the elements of a container between the open and close characters.
+ * An element that would leave no room within the budget for the
+ * "... (N elements)" suffix and the close character is removed again,
+ * and the suffix takes its place, so the count survives the final truncation.
+ */
+template <typename AppendFcn>
+static void appendElements(std::string &out, const char open, const char close,
+    const size_t num, const char *noun, const size_t maxChars, const AppendFcn &appendOne)
+{
+    out += open;
+    const auto suffix = "... (" + std::to_string(num) + " " + noun + ")";
+    for (size_t i = 0; i < num; i++)
+    {
+        const size_t mark = out.size();
+        if (i != 0) out += ", ";
+        appendOne(out, i);
+
+        //the last element only needs room for the close character
+        const size_t reserve = (i+1 == num)? 1 : 2+suffix.size()+1;
+        if (out.size()+reserve <= maxChars) continue;
+        out.resize(mark);
+        if (i != 0) out += ", ";
+        out += suffix;
+        break;
+    }
+    out += close;
+}
+
+template <typename ElemType, typename Type>
+static void appendVector(std::string &out, const std::vector<Type> &vec, const size_t maxChars)
+{
+    appendElements(out, '[', ']', vec.size(), "elements", maxChars,
+        [&vec](std::string &o, const size_t i){appendElement(o, ElemType(vec[i]));});
+}
+
+static void appendStringVector(std::string &out, const std::vector<std::string> &vec, const size_t maxChars)
+{
+    appendElements(out, '[', ']', vec.size(), "elements", maxChars,
+        [&vec, maxChars](std::string &o, const size_t i){appendString(o, vec[i], maxChars);});
+}
+
+static void appendObjectVector(std::string &out, const Pothos::ObjectVector &vec, const size_t maxChars)
+{
+    appendElements(out, '[', ']', vec.size(), "elements", maxChars,
+        [&vec, maxChars](std::string &o, const size_t i){appendBounded(o, vec[i], maxChars);});
+}
+
+static void appendKey(std::string &out, const std::string &key, const size_t maxChars)
+{
+    appendString(out, key, maxChars);
+}
+
+static void appendKey(std::string &out, const Pothos::Object &key, const size_t maxChars)
+{
+    appendBounded(out, key, maxChars);
+}
+
+template <typename MapType>
+static void appendMap(std::string &out, const MapType &map, const size_t maxChars)
+{
+    //map iterators only step forward, the callback is invoked with increasing indexes
+    auto it = map.begin();
+    appendElements(out, '{', '}', map.size(), "entries", maxChars,
+        [&it, maxChars](std::string &o, const size_t)
+        {
+            appendKey(o, it->first, maxChars);
+            o += ": ";
+            appendBounded(o, it->second, maxChars);
+            ++it;
+        });
+}
+
+static void appendBuffer(std::string &out, const Pothos::BufferChunk &buff)
+{
+    out += std::to_string(buff.elements()) + " x " + buff.dtype.toString();
+}
+
+/*!
+ * Append a string representation of the object to the output,
+ * stopping once the output holds at least maxChars characters.
+ * Common containers are formatted element by element,
+ * so that large containers are never fully stringified.
+ */
+static void appendBounded(std::string &out, const Pothos::Object &obj, const size_t maxChars)
+{
+    #define ifTypeAppendVector(type, elemType) \
+        if (obj.type() == typeid(std::vector<type>)) return appendVector<elemType>(out, obj.extract<std::vector<type>>(), maxChars);
+    ifTypeAppendVector(double, double)
+    ifTypeAppendVector(float, double)
+    ifTypeAppendVector(long long, long long)
+    ifTypeAppendVector(long, long long)
+    ifTypeAppendVector(int, long long)
+    ifTypeAppendVector(short, long long)
+    ifTypeAppendVector(unsigned long long, unsigned long long)
+    ifTypeAppendVector(unsigned long, unsigned long long)
+    ifTypeAppendVector(unsigned int, unsigned long long)
+    ifTypeAppendVector(unsigned short, unsigned long long)
+    ifTypeAppendVector(std::complex<double>, std::complex<double>)
+    ifTypeAppendVector(std::complex<float>, std::complex<double>)
+    #undef ifTypeAppendVector
+
+    if (obj.type() == typeid(Pothos::ObjectVector))
+    {
+        return appendObjectVector(out, obj.extract<Pothos::ObjectVector>(), maxChars);
+    }
+    if (obj.type() == typeid(std::vector<std::string>))
+    {
+        return appendStringVector(out, obj.extract<std::vector<std::string>>(), maxChars);
+    }
+    if (obj.type() == typeid(Pothos::ObjectMap))
+    {
+        return appendMap(out, obj.extract<Pothos::ObjectMap>(), maxChars);
+    }
+    if (obj.type() == typeid(Pothos::ObjectKwargs))
+    {
+        return appendMap(out, obj.extract<Pothos::ObjectKwargs>(), maxChars);
+    }
+    if (obj.type() == typeid(std::string))
+    {
+        return appendString(out, obj.extract<std::string>(), maxChars);
+    }
+    if (obj.type() == typeid(QString))
+    {
+        const auto &str = obj.extract<QString>();
+        out += str.left(int(maxChars+1)).toStdString();
+        return;
+    }
+    if (obj.type() == typeid(Pothos::BufferChunk))
+    {
+        out += "BufferChunk(";
+        appendBuffer(out, obj.extract<Pothos::BufferChunk>());
+        out += ')';
+        return;
+    }
+    if (obj.type() == typeid(Pothos::Packet))
+    {
+        const auto &pkt = obj.extract<Pothos::Packet>();
+        out += "Packet(";
+        appendBuffer(out, pkt.payload);
+        out += ", " + std::to_string(pkt.metadata.size()) + " metadata";
+        out += ", " + std::to_string(pkt.labels.size()) + " labels)";
+        return;
+    }
+
+    //fall-back to the generic stringify for other types,
+    //which cannot be interrupted, but only the budget is kept
+    appendString(out, obj.toString(), maxChars);
+}
+
+static QString truncatedString(const QString &str, const size_t maxChars)
+{
+    if (size_t(str.size()) <= maxChars) return str;
+    return str.left(int(std::max<size_t>(maxChars, 3)-3)) + "...";
+}
+
+/*!
+ * Stringify the object with a character budget,
+ * the result is truncated with an ellipsis when the budget is exceeded.
+ */
+static QString boundedToString(const Pothos::Object &obj, const size_t maxChars)
+{
+    std::string out;
+    appendBounded(out, obj, maxChars);
+    return truncatedString(QString::fromStdString(out), maxChars);
+}
+
+POTHOS_TEST_BLOCK("/widgets/tests", test_text_display_bounded_string)
+{
+    POTHOS_TEST_TRUE(boundedToString(Pothos::Object(std::vector<int>{1, 2, 3}), 80) == "[1, 2, 3]");
+    POTHOS_TEST_TRUE(boundedToString(Pothos::Object(std::string("hello")), 80) == "hello");
+    POTHOS_TEST_TRUE(boundedToString(Pothos::Object(std::string("hello world")), 8) == "hello...");
+    POTHOS_TEST_TRUE(boundedToString(Pothos::Object(std::vector<unsigned long long>{18446744073709551615ull}), 80) == "[18446744073709551615]");
+
+    const std::vector<std::string> strs(100000, "abc");
+    const auto strsStr = boundedToString(Pothos::Object(strs), 80);
+    POTHOS_TEST_TRUE(strsStr.size() <= 80);
+    POTHOS_TEST_TRUE(strsStr.startsWith("[abc, abc, "));
+    POTHOS_TEST_TRUE(strsStr.endsWith(", ... (100000 elements)]"));
+
+    const std::vector<double> big(100000, 1.5);
+    const auto str = boundedToString(Pothos::Object(big), 80);
+    POTHOS_TEST_TRUE(str.size() <= 80);
+    POTHOS_TEST_TRUE(str.startsWith("[1.5, 1.5, "));
+    POTHOS_TEST_TRUE(str.endsWith(", ... (100000 elements)]"));
+
+    //an element larger than the budget is replaced by the count
+    const std::vector<std::string> longStrs(2, std::string(200, 'x'));
+    POTHOS_TEST_TRUE(boundedToString(Pothos::Object(longStrs), 80) == "[... (2 elements)]");
+}
+
+/***********************************************************************
+ * Windowed statistics over stream buffers
+ **********************************************************************/
+struct StreamStats
+{
+    StreamStats(void)
+    {
+        this->reset();
+    }
+
+    void reset(void)
+    {
+        count = 0;
+        sum = std::complex<double>();
+        sumSq = 0.0;
+        min = std::numeric_limits<double>::infinity();
+        max = -std::numeric_limits<double>::infinity();
+    }
+
+    size_t count;
+    std::complex<double> sum;
+    double sumSq; //sum of |x|^2
+    double min; //of x for real types, |x|^2 for complex types
+    double max;
+    std::complex<double> last;
+};
+
+/*!
+ * Accumulate a block of samples into the statistics.
+ * The loop keeps independent accumulator lanes
+ * so that the compiler can vectorize the reduction.
+ */
+template <typename Type>
+static void accumulateStats(const Type *in, const size_t num, StreamStats &st)
+{
+    static const size_t L = 4;
+    double sum[L], sumSq[L], min[L], max[L];
+    for (size_t k = 0; k < L; k++)
+    {
+        sum[k] = 0.0; sumSq[k] = 0.0;
+        min[k] = st.min; max[k] = st.max;
+    }
+
+    size_t i = 0;
+    for (; i+L <= num; i += L)
+    {
+        for (size_t k = 0; k < L; k++)
+        {
+            const double x = double(in[i+k]);
+            sum[k] += x;
+            sumSq[k] += x*x;
+            min[k] = std::min(min[k], x);
+            max[k] = std::max(max[k], x);
+        }
+    }
+    for (; i < num; i++)
+    {
+        const double x = double(in[i]);
+        sum[0] += x;
+        sumSq[0] += x*x;
+        min[0] = std::min(min[0], x);
+        max[0] = std::max(max[0], x);
+    }
+
+    for (size_t k = 0; k < L; k++)
+    {
+        st.sum += sum[k];
+        st.sumSq += sumSq[k];
+        st.min = std::min(st.min, min[k]);
+        st.max = std::max(st.max, max[k]);
+    }
+    st.count += num;
+    if (num != 0) st.last = double(in[num-1]);
+}
+
+template <typename Type>
+static void accumulateStats(const std::complex<Type> *in, const size_t num, StreamStats &st)
+{
+    static const size_t L = 4;
+    double sumRe[L], sumIm[L], sumSq[L], min[L], max[L];
+    for (size_t k = 0; k < L; k++)
+    {
+        sumRe[k] = 0.0; sumIm[k] = 0.0; sumSq[k] = 0.0;
+        min[k] = st.min; max[k] = st.max;
+    }
+
+    size_t i = 0;
+    for (; i+L <= num; i += L)
+    {
+        for (size_t k = 0; k < L; k++)
+        {
+            const double re = double(in[i+k].real());
+            const double im = double(in[i+k].imag());
+            const double mag2 = re*re + im*im;
+            sumRe[k] += re;
+            sumIm[k] += im;
+            sumSq[k] += mag2;
+            min[k] = std::min(min[k], mag2);
+            max[k] = std::max(max[k], mag2);
+        }
+    }
+    for (; i < num; i++)
+    {
+        const double re = double(in[i].real());
+        const double im = double(in[i].imag());
+        const double mag2 = re*re + im*im;
+        sumRe[0] += re;
+        sumIm[0] += im;
+        sumSq[0] += mag2;
+        min[0] = std::min(min[0], mag2);
+        max[0] = std::max(max[0], mag2);
+    }
+
+    for (size_t k = 0; k < L; k++)
+    {
+        st.sum += std::complex<double>(sumRe[k], sumIm[k]);
+        st.sumSq += sumSq[k];
+        st.min = std::min(st.min, min[k]);
+        st.max = std::max(st.max, max[k]);
+    }
+    st.count += num;
+    if (num != 0) st.last = std::complex<double>(in[num-1].real(), in[num-1].imag());
+}
 
 /***********************************************************************
  * |PothosDoc Text Display
@@ -11,12 +379,35 @@
  * The text display widget display's a formatted string.
  * The display value can be set through one of the set*Value() slots.
  * Display values can be strings, floating point, and integers.
+ * The setFloatValues() slot substitutes a list of numbers into
+ * the %1, %2, %3... place markers of the format string.
  *
  * For arbitrary value types, use the generic setValue() slot.
  * This slot uses the capability of Pothos::Object() to stringify.
+ * Vectors, packets, and buffers are summarized element by element,
+ * and string values are truncated to the maximum display length.
+ *
+ * The derived mode displays the delta or rate of change of the values
+ * passed to setIntValue() and setFloatValue(), such as monotonic counters.
+ *
+ * Display updates are coalesced: when values arrive faster than
+ * the GUI can redraw, only the newest value is displayed,
+ * and the older values are counted by getDroppedUpdates().
+ *
+ * <h2>Stream input</h2>
+ * In stream input mode, the text display has an input port that accepts
+ * real and complex buffers of floating point and integer samples.
+ * The display shows a statistic computed over a window of input samples.
+ * Minimum, maximum, and RMS statistics of complex samples use the magnitude.
  *
  * |category /Widgets
- * |keywords text display label
+ * |keywords text display label stream statistic
+ *
+ * |param portMode [Port Mode] Enable an optional stream input port.
+ * |default "NONE"
+ * |option [None] "NONE"
+ * |option [Stream Input] "STREAM"
+ * |preview disable
  *
  * |param title The name of the value displayed by this widget
  * |default "My Text Value"
@@ -36,35 +427,128 @@
  * |preview disable
  * |widget ComboBox(editable=true)
  *
+ * |param derivedMode [Derived Mode] Display a value derived from successive numeric values.
+ * The delta mode displays the difference since the last value.
+ * The rate mode displays the difference per second since the last value.
+ * The smoothed rate mode averages the rate with an exponentially weighted moving average.
+ * |default "VALUE"
+ * |option [Value] "VALUE"
+ * |option [Delta] "DELTA"
+ * |option [Rate] "RATE"
+ * |option [Smoothed Rate] "EWMA"
+ * |preview disable
+ *
+ * |param smoothing The weight of each new rate in the smoothed rate mode.
+ * |default 0.2
+ * |preview when(enum=derivedMode, "EWMA")
+ *
+ * |param maxLength [Max Length] The maximum number of characters displayed for a value.
+ * |default 80
+ * |widget SpinBox(minimum=4)
+ * |preview disable
+ *
+ * |param notation The notation used for floating point formatting.
+ * |default "GENERAL"
+ * |option [General] "GENERAL"
+ * |option [Fixed] "FIXED"
+ * |option [Scientific] "SCIENTIFIC"
+ * |preview disable
+ *
+ * |param precision The number of significant digits for general notation,
+ * or the number of digits after the decimal point for fixed and scientific notation.
+ * Use -1 for the shortest representation that preserves the exact value.
+ * |default 6
+ * |widget SpinBox(minimum=-1, maximum=17)
+ * |preview disable
+ *
+ * |param refreshRate [Refresh Rate] The maximum number of display updates per second.
+ * Use 0.0 to redraw once per GUI event loop iteration without a rate limit.
+ * |units Hz
+ * |default 0.0
+ * |preview disable
+ *
+ * |param renderMode [Render Mode] How the title and value are drawn.
+ * The rich text mode formats the title and value as HTML in the label.
+ * The static text mode draws a cached bold title and re-lays-out only the value,
+ * which avoids rich text parsing on every update.
+ * |default "RICHTEXT"
+ * |option [Rich Text] "RICHTEXT"
+ * |option [Static Text] "STATIC"
+ * |preview disable
+ *
+ * |param statistic The statistic displayed for the stream input.
+ * |default "MEAN"
+ * |option [Mean] "MEAN"
+ * |option [Minimum] "MIN"
+ * |option [Maximum] "MAX"
+ * |option [RMS] "RMS"
+ * |option [Last Sample] "LAST"
+ * |preview when(enum=portMode, "STREAM")
+ *
+ * |param windowSize [Window Size] The number of stream samples per displayed statistic.
+ * |default 1024
+ * |preview when(enum=portMode, "STREAM")
+ *
  * |mode graphWidget
- * |factory /widgets/text_display()
+ * |factory /widgets/text_display(portMode)
  * |setter setTitle(title)
  * |setter setFormatStr(formatStr)
  * |setter setBase(base)
+ * |setter setDerivedMode(derivedMode)
+ * |setter setSmoothing(smoothing)
+ * |setter setMaxLength(maxLength)
+ * |setter setNotation(notation)
+ * |setter setPrecision(precision)
+ * |setter setRefreshRate(refreshRate)
+ * |setter setRenderMode(renderMode)
+ * |setter setStatistic(statistic)
+ * |setter setWindowSize(windowSize)
  **********************************************************************/
 class TextDisplay : public QLabel, public Pothos::Block
 {
     Q_OBJECT
 public:
 
-    static Block *make(void)
+    static Block *make(const std::string &portMode)
     {
-        return new TextDisplay();
+        return new TextDisplay(portMode);
     }
 
-    TextDisplay(void):
-        _base(10)
+    TextDisplay(const std::string &portMode):
+        _maxLength(80),
+        _statistic(STAT_MEAN),
+        _windowSize(1024),
+        _refreshPeriodMs(0),
+        _droppedUpdates(0),
+        _updatePending(false),
+        _staticMode(false),
+        _staticTitleDirty(true),
+        _valueOffset(0.0)
     {
         this->setFormatStr("%1");
         this->registerCall(this, POTHOS_FCN_TUPLE(TextDisplay, widget));
         this->registerCall(this, POTHOS_FCN_TUPLE(TextDisplay, setTitle));
         this->registerCall(this, POTHOS_FCN_TUPLE(TextDisplay, setFormatStr));
         this->registerCall(this, POTHOS_FCN_TUPLE(TextDisplay, setBase));
+        this->registerCall(this, POTHOS_FCN_TUPLE(TextDisplay, setDerivedMode));
+        this->registerCall(this, POTHOS_FCN_TUPLE(TextDisplay, setSmoothing));
+        this->registerCall(this, POTHOS_FCN_TUPLE(TextDisplay, setMaxLength));
+        this->registerCall(this, POTHOS_FCN_TUPLE(TextDisplay, setNotation));
+        this->registerCall(this, POTHOS_FCN_TUPLE(TextDisplay, setPrecision));
+        this->registerCall(this, POTHOS_FCN_TUPLE(TextDisplay, setRefreshRate));
+        this->registerCall(this, POTHOS_FCN_TUPLE(TextDisplay, getDroppedUpdates));
+        this->registerCall(this, POTHOS_FCN_TUPLE(TextDisplay, setRenderMode));
+        this->registerCall(this, POTHOS_FCN_TUPLE(TextDisplay, setStatistic));
+        this->registerCall(this, POTHOS_FCN_TUPLE(TextDisplay, setWindowSize));
         this->registerCall(this, POTHOS_FCN_TUPLE(TextDisplay, setStringValue));
         this->registerCall(this, POTHOS_FCN_TUPLE(TextDisplay, setFloatValue));
         this->registerCall(this, POTHOS_FCN_TUPLE(TextDisplay, setComplexValue));
         this->registerCall(this, POTHOS_FCN_TUPLE(TextDisplay, setIntValue));
+        this->registerCall(this, POTHOS_FCN_TUPLE(TextDisplay, setFloatValues));
         this->registerCall(this, POTHOS_FCN_TUPLE(TextDisplay, setValue));
+
+        if (portMode == "STREAM") this->setupInput(0);
+        else if (portMode != "NONE") throw Pothos::InvalidArgumentException("TextDisplay("+portMode+")", "unknown port mode");
     }
 
     QWidget *widget(void)
@@ -81,57 +565,348 @@ public:
     void setFormatStr(const QString &formatStr)
     {
         if (not formatStr.contains("%1")) throw Pothos::Exception("Format string missing %1");
-        _formatStr = formatStr;
+        _format.setFormat(formatStr);
         this->update();
     }
 
     void setBase(const size_t base)
     {
-        _base = base;
+        if (base < 2 or base > 36) throw Pothos::RangeException("TextDisplay::setBase()", "base must be between 2 and 36");
+        _format.setBase(int(base));
+    }
+
+    void setDerivedMode(const std::string &mode)
+    {
+        _derived.setMode(mode);
+    }
+
+    void setSmoothing(const double alpha)
+    {
+        _derived.setSmoothing(alpha);
+    }
+
+    void setMaxLength(const size_t maxLength)
+    {
+        if (maxLength < 4) throw Pothos::RangeException("TextDisplay::setMaxLength()", "max length must be at least 4");
+        _maxLength = maxLength;
+    }
+
+    void setNotation(const std::string &notation)
+    {
+        if (notation == "GENERAL") _format.setNotation(FormatEngine::GENERAL);
+        else if (notation == "FIXED") _format.setNotation(FormatEngine::FIXED);
+        else if (notation == "SCIENTIFIC") _format.setNotation(FormatEngine::SCIENTIFIC);
+        else throw Pothos::InvalidArgumentException("TextDisplay::setNotation("+notation+")", "unknown notation");
+    }
+
+    void setPrecision(const int precision)
+    {
+        _format.setPrecision(precision);
+    }
+
+    void setRefreshRate(const double rate)
+    {
+        if (rate < 0.0) throw Pothos::RangeException("TextDisplay::setRefreshRate()", "rate must be non-negative");
+        _refreshPeriodMs = (rate == 0.0)? 0 : qint64(1000.0/rate);
+    }
+
+    unsigned long long getDroppedUpdates(void) const
+    {
+        return _droppedUpdates.load();
+    }
+
+    void setRenderMode(const std::string &mode)
+    {
+        if (mode == "RICHTEXT") _staticMode = false;
+        else if (mode == "STATIC") _staticMode = true;
+        else throw Pothos::InvalidArgumentException("TextDisplay::setRenderMode("+mode+")", "unknown render mode");
+        this->update();
+    }
+
+    QSize sizeHint(void) const
+    {
+        if (not _staticMode) return QLabel::sizeHint();
+        return _staticSizeHint;
+    }
+
+    QSize minimumSizeHint(void) const
+    {
+        if (not _staticMode) return QLabel::minimumSizeHint();
+        return _staticSizeHint;
+    }
+
+    void setStatistic(const std::string &statistic)
+    {
+        if (statistic == "MEAN") _statistic = STAT_MEAN;
+        else if (statistic == "MIN") _statistic = STAT_MIN;
+        else if (statistic == "MAX") _statistic = STAT_MAX;
+        else if (statistic == "RMS") _statistic = STAT_RMS;
+        else if (statistic == "LAST") _statistic = STAT_LAST;
+        else throw Pothos::InvalidArgumentException("TextDisplay::setStatistic("+statistic+")", "unknown statistic");
+    }
+
+    void setWindowSize(const size_t windowSize)
+    {
+        if (windowSize == 0) throw Pothos::RangeException("TextDisplay::setWindowSize()", "window size must be positive");
+        _windowSize = windowSize;
+        _stats.reset();
+    }
+
+    void activate(void)
+    {
+        _stats.reset();
+    }
+
+    void work(void)
+    {
+        if (this->inputs().empty()) return;
+        auto inPort = this->input(0);
+        const auto &buff = inPort->buffer();
+        const size_t elems = inPort->elements();
+        if (elems == 0) return;
+
+        //reduce entire windows, only the newest complete window is displayed
+        const auto elemSize = buff.dtype.size();
+        bool complete = false;
+        StreamStats result;
+        size_t i = 0;
+        while (i < elems)
+        {
+            const size_t n = std::min(elems-i, _windowSize-_stats.count);
+            this->accumulate(buff.as<const char *>()+i*elemSize, n, buff.dtype);
+            i += n;
+            if (_stats.count < _windowSize) break;
+            result = _stats;
+            complete = true;
+            _stats.reset();
+        }
+        inPort->consume(elems);
+
+        if (complete) this->displayStats(result, buff.dtype);
     }
 
     void setStringValue(const QString &value)
     {
-        _valueStr = _formatStr.arg(value);
+        _valueStr = _format.format(truncatedString(value, _maxLength));
         this->update();
     }
 
     void setFloatValue(const double value)
     {
-        _valueStr = _formatStr.arg(value);
+        _valueStr = _format.format(_derived.update(value));
         this->update();
     }
 
     void setComplexValue(const std::complex<double> value)
     {
-        _valueStr = QString("%1+%2j").arg(_formatStr.arg(value.real())).arg(_formatStr.arg(value.imag()));
+        _valueStr = _format.format(value);
         this->update();
     }
 
     void setIntValue(const int value)
     {
-        _valueStr = _formatStr.arg(value, 0, _base);
+        this->setInt64Value(value);
+    }
+
+    void setFloatValues(const std::vector<double> &values)
+    {
+        _valueStr = _format.format(values);
         this->update();
     }
 
     void setValue(const Pothos::Object &obj)
     {
-        _valueStr = _formatStr.arg(QString::fromStdString(obj.toString()));
+        _valueStr = _format.format(boundedToString(obj, _maxLength));
         this->update();
     }
 
+private slots:
+
+    void handleUpdate(void)
+    {
+        //defer until the refresh period has elapsed, newer values replace the pending text meanwhile
+        if (_lastRefresh.isValid())
+        {
+            const auto remaining = _refreshPeriodMs.load() - _lastRefresh.elapsed();
+            if (remaining > 0)
+            {
+                QTimer::singleShot(int(remaining), this, &TextDisplay::handleUpdate);
+                return;
+            }
+        }
+
+        QString title, value;
+        {
+            std::lock_guard<std::mutex> lock(_pendingMutex);
+            title = _pendingTitle;
+            value = _pendingValue;
+            _updatePending = false;
+        }
+        _lastRefresh.start();
+
+        if (_staticMode) this->updateStaticText(title, value);
+        else
+        {
+            _staticTitle = QString();
+            _staticTitleDirty = true;
+            this->setText(QString("<b>%1:</b> %2").arg(title.toHtmlEscaped()).arg(value.toHtmlEscaped()));
+        }
+    }
+
+protected:
+
+    void paintEvent(QPaintEvent *event)
+    {
+        if (not _staticMode) return QLabel::paintEvent(event);
+
+        QPainter painter(this);
+        const auto r = this->contentsRect();
+        const qreal h = std::max(_titleText.size().height(), _valueText.size().height());
+        const qreal y = r.top() + (r.height() - h)/2;
+        painter.setFont(_boldFont);
+        painter.drawStaticText(QPointF(r.left(), y), _titleText);
+        painter.setFont(this->font());
+        painter.drawStaticText(QPointF(r.left() + _valueOffset, y), _valueText);
+    }
+
 private:
 
+    void accumulate(const void *in, const size_t num, const Pothos::DType &dtype)
+    {
+        #define ifTypeAccumulate(type) \
+            if (dtype == Pothos::DType(typeid(type))) return accumulateStats(reinterpret_cast<const type *>(in), num, _stats);
+        ifTypeAccumulate(double)
+        ifTypeAccumulate(float)
+        ifTypeAccumulate(int64_t)
+        ifTypeAccumulate(int32_t)
+        ifTypeAccumulate(int16_t)
+        ifTypeAccumulate(int8_t)
+        ifTypeAccumulate(uint64_t)
+        ifTypeAccumulate(uint32_t)
+        ifTypeAccumulate(uint16_t)
+        ifTypeAccumulate(uint8_t)
+        ifTypeAccumulate(std::complex<double>)
+        ifTypeAccumulate(std::complex<float>)
+        ifTypeAccumulate(std::complex<int64_t>)
+        ifTypeAccumulate(std::complex<int32_t>)
+        ifTypeAccumulate(std::complex<int16_t>)
+        ifTypeAccumulate(std::complex<int8_t>)
+        #undef ifTypeAccumulate
+        throw Pothos::DataFormatException("TextDisplay::work()", "unsupported dtype: "+dtype.toString());
+    }
+
+    void displayStats(const StreamStats &st, const Pothos::DType &dtype)
+    {
+        const double N = double(st.count);
+        if (dtype.isComplex()) switch (_statistic)
+        {
+        case STAT_MEAN: return this->setComplexValue(st.sum/N);
+        case STAT_MIN: return this->setFloatValue(std::sqrt(st.min));
+        case STAT_MAX: return this->setFloatValue(std::sqrt(st.max));
+        case STAT_RMS: return this->setFloatValue(std::sqrt(st.sumSq/N));
+        case STAT_LAST: return this->setComplexValue(st.last);
+        }
+
+        //integer samples keep the integer formatter base unless averaged
+        const bool isInt = dtype.isInteger();
+        switch (_statistic)
+        {
+        case STAT_MEAN: return this->setFloatValue(st.sum.real()/N);
+        case STAT_MIN: return isInt? this->setInt64Value(qlonglong(st.min)) : this->setFloatValue(st.min);
+        case STAT_MAX: return isInt? this->setInt64Value(qlonglong(st.max)) : this->setFloatValue(st.max);
+        case STAT_RMS: return this->setFloatValue(std::sqrt(st.sumSq/N));
+        case STAT_LAST: return isInt? this->setInt64Value(qlonglong(st.last.real())) : this->setFloatValue(st.last.real());
+        }
+    }
+
+    void setInt64Value(const qlonglong value)
+    {
+        //integer formatting applies unless the derived value is a rate
+        const auto mode = _derived.mode();
+        const auto derived = _derived.update(double(value));
+        if (mode == DerivedValue::VALUE) _valueStr = _format.format((long long)(value));
+        else if (mode == DerivedValue::DELTA) _valueStr = _format.format((long long)(std::llround(derived)));
+        else _valueStr = _format.format(derived);
+        this->update();
+    }
+
     void update(void)
     {
-        const auto text = QString("<b>%1:</b> %2").arg(_title.toHtmlEscaped()).arg(_valueStr.toHtmlEscaped());
-        QMetaObject::invokeMethod(this, "setText", Qt::QueuedConnection, Q_ARG(QString, text));
+        //latest value wins: only one update is ever queued to the GUI thread
+        std::lock_guard<std::mutex> lock(_pendingMutex);
+        _pendingTitle = _title;
+        _pendingValue = _valueStr;
+        if (_updatePending)
+        {
+            _droppedUpdates++;
+            return;
+        }
+        _updatePending = true;
+        QMetaObject::invokeMethod(this, "handleUpdate", Qt::QueuedConnection);
+    }
+
+    void updateStaticText(const QString &title, const QString &value)
+    {
+        if (not this->text().isEmpty()) this->clear();
+
+        if (_staticTitleDirty or title != _staticTitle)
+        {
+            _staticTitle = title;
+            _staticTitleDirty = false;
+            _boldFont = this->font();
+            _boldFont.setBold(true);
+            _titleText.setTextFormat(Qt::PlainText);
+            _titleText.setText(title + ":");
+            _titleText.prepare(QTransform(), _boldFont);
+            _valueOffset = _titleText.size().width() + QFontMetrics(this->font()).horizontalAdvance(' ');
+            _staticSizeHint = QSize();
+        }
+
+        _valueText.setTextFormat(Qt::PlainText);
+        _valueText.setText(value);
+        _valueText.prepare(QTransform(), this->font());
+
+        //only relayout when the content outgrows the current size hint
+        const auto m = this->contentsMargins();
+        const QSize needed(
+            int(std::ceil(_valueOffset + _valueText.size().width())) + m.left() + m.right(),
+            int(std::ceil(std::max(_titleText.size().height(), _valueText.size().height()))) + m.top() + m.bottom());
+        if (needed.width() > _staticSizeHint.width() or needed.height() > _staticSizeHint.height())
+        {
+            _staticSizeHint = _staticSizeHint.expandedTo(needed);
+            this->updateGeometry();
+        }
+        QWidget::update();
     }
 
-    size_t _base;
+    FormatEngine _format;
+    size_t _maxLength;
+    DerivedValue _derived;
+    enum Statistic {STAT_MEAN, STAT_MIN, STAT_MAX, STAT_RMS, STAT_LAST};
+    Statistic _statistic;
+    size_t _windowSize;
+    StreamStats _stats;
     QString _title;
     QString _valueStr;
-    QString _formatStr;
+
+    //update coalescing state
+    std::atomic<qint64> _refreshPeriodMs;
+    std::atomic<unsigned long long> _droppedUpdates;
+    std::mutex _pendingMutex;
+    QString _pendingTitle;
+    QString _pendingValue;
+    bool _updatePending;
+    QElapsedTimer _lastRefresh;
+    std::atomic<bool> _staticMode;
+
+    //static text render state, only accessed in the GUI thread
+    bool _staticTitleDirty;
+    QString _staticTitle;
+    QFont _boldFont;
+    QStaticText _titleText;
+    QStaticText _valueText;
+    qreal _valueOffset;
+    QSize _staticSizeHint;
 };
 
 static Pothos::BlockRegistry registerTextDisplay(
@@ -0,0 +1,60 @@
+// Copyright (c) 2026 agent
+// SPDX-License-Identifier: BSL-1.0
+
+#include "ValueMirror.hpp"
+#include <Pothos/Testing.hpp>
+#include <thread>
+#include <cmath> //abs
+
+/***********************************************************************
+ * Concurrent store and load, a torn or stale read fails the test.
+ * The mirror uses only atomics, so this also runs clean under -fsanitize=thread.
+ **********************************************************************/
+struct MirrorTestPair
+{
+    double a;
+    double b;
+};
+
+POTHOS_TEST_BLOCK("/widgets/tests", test_value_mirror)
+{
+    static const int numStores = 200000;
+
+    ValueMirror<MirrorTestPair> mirror(MirrorTestPair{0.0, 0.0});
+    std::atomic<bool> done(false);
+    std::thread writer([&]
+    {
+        for (int i = 1; i <= numStores; i++) mirror.store(MirrorTestPair{double(i), -double(i)});
+        done = true;
+    });
+
+    size_t bad = 0;
+    double last = 0.0;
+    while (not done)
+    {
+        const auto pair = mirror.load();
+        if (pair.a != -pair.b or pair.a < last) bad++;
+        last = pair.a;
+    }
+    writer.join();
+    POTHOS_TEST_EQUAL(bad, size_t(0));
+    POTHOS_TEST_EQUAL(mirror.load().a, double(numStores));
+
+    //stores from two threads are serialized, readers never see a torn pair
+    std::atomic<int> writersDone(0);
+    auto storeAll = [&](const double sign)
+    {
+        for (int i = 1; i <= numStores; i++) mirror.store(MirrorTestPair{sign*i, -sign*i});
+        writersDone++;
+    };
+    std::thread writer0(storeAll, +1.0), writer1(storeAll, -1.0);
+    while (writersDone != 2)
+    {
+        const auto pair = mirror.load();
+        if (pair.a != -pair.b) bad++;
+    }
+    writer0.join();
+    writer1.join();
+    POTHOS_TEST_EQUAL(bad, size_t(0));
+    POTHOS_TEST_EQUAL(std::abs(mirror.load().a), double(numStores));
+}
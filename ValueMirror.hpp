@@ -0,0 +1,69 @@
+// Copyright (c) 2026 agent
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include <type_traits>
+#include <cstring> //memcpy
+#include <cstdint>
+#include <atomic>
+
+/*!
+ * A copy of a widget's committed value that any thread can read without locking.
+ *
+ * The GUI thread stores the value whenever the widget commits a change,
+ * and getters called from block threads load it instead of touching the widget.
+ * The value is kept in atomic words under a sequence counter (a seqlock):
+ * a single word value is read in one pass, and a compound value is read again
+ * only if it was torn by a concurrent store. A store claims the odd sequence
+ * number with a compare and swap, so stores from several threads are serialized.
+ */
+template <typename T>
+class ValueMirror
+{
+    static_assert(std::is_trivially_copyable<T>::value, "ValueMirror requires a trivially copyable type");
+    static const size_t NUM_WORDS = (sizeof(T)+sizeof(std::uint64_t)-1)/sizeof(std::uint64_t);
+
+public:
+    ValueMirror(const T &value = T()):
+        _seq(0)
+    {
+        this->store(value);
+    }
+
+    void store(const T &value)
+    {
+        std::uint64_t words[NUM_WORDS] = {};
+        std::memcpy(words, &value, sizeof(T));
+
+        //an odd sequence number marks a store in progress,
+        //claiming it waits out a concurrent store from another thread,
+        //the release stores order the odd number before any new word
+        auto seq = _seq.load(std::memory_order_relaxed);
+        while ((seq & 1) != 0 or not _seq.compare_exchange_weak(seq, seq+1, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            seq = _seq.load(std::memory_order_relaxed);
+        }
+        for (size_t i = 0; i < NUM_WORDS; i++) _words[i].store(words[i], std::memory_order_release);
+        _seq.store(seq+2, std::memory_order_release);
+    }
+
+    T load(void) const
+    {
+        std::uint64_t words[NUM_WORDS];
+        while (true)
+        {
+            //a new word read here implies the odd sequence number is seen below
+            const auto seq0 = _seq.load(std::memory_order_acquire);
+            for (size_t i = 0; i < NUM_WORDS; i++) words[i] = _words[i].load(std::memory_order_acquire);
+            const auto seq1 = _seq.load(std::memory_order_relaxed);
+            if (seq0 == seq1 and (seq0 & 1) == 0) break;
+        }
+        T value;
+        std::memcpy(&value, words, sizeof(T));
+        return value;
+    }
+
+private:
+    std::atomic<std::uint64_t> _seq;
+    std::atomic<std::uint64_t> _words[NUM_WORDS];
+};
@@ -6,16 +6,113 @@
 #include <QtWidgets/QHBoxLayout>
 #include <QtWidgets/QLabel>
 #include <QtGui/QMouseEvent>
+#include <QtGui/QBrush>
+#include <QtGui/QCursor>
+#include <QtGui/QPainter>
+#include <QtGui/QPixmap>
+#include <QtCore/QHash>
 
 #include "indicator.h"
 
 //------------------------------------------------------------------------------
 
-static const QString c_StyleSheets[3] =
+// digit palettes are built once per indicator, changing a palette does not re-polish like a style sheet
+
+static QPalette makeDigitPalette(const QPalette &base, const QColor &color, int state)
 {
-  "color: %1;",
-  "color: %1; background-color: qlineargradient(spread:pad, x1:0, y1:0, x2:0, y2:1, stop:0 rgba(255, 153, 153, 255), stop:0.49 rgba(255, 153, 153, 255), stop:0.50 rgba(0, 0, 0, 0), stop:1 rgba(0, 0, 0, 0))",
-  "color: %1; background-color: qlineargradient(spread:pad, x1:0, y1:0, x2:0, y2:1, stop:0 rgba(0, 0, 0, 0), stop:0.50 rgba(0, 0, 0, 0), stop:0.51 rgba(153, 204, 255, 255), stop:1 rgba(153, 204, 255, 255))"
+  QPalette palette(base);
+  QLinearGradient gradient(0, 0, 0, 1);
+  gradient.setCoordinateMode(QGradient::ObjectBoundingMode);
+  if(state == 1)
+  {
+    gradient.setColorAt(0.00, QColor(255, 153, 153));
+    gradient.setColorAt(0.49, QColor(255, 153, 153));
+    gradient.setColorAt(0.50, Qt::transparent);
+    gradient.setColorAt(1.00, Qt::transparent);
+    palette.setBrush(QPalette::Window, gradient);
+  }
+  else if(state == 2)
+  {
+    gradient.setColorAt(0.00, Qt::transparent);
+    gradient.setColorAt(0.50, Qt::transparent);
+    gradient.setColorAt(0.51, QColor(153, 204, 255));
+    gradient.setColorAt(1.00, QColor(153, 204, 255));
+    palette.setBrush(QPalette::Window, gradient);
+  }
+  else
+  {
+    palette.setBrush(QPalette::Window, Qt::transparent);
+  }
+  palette.setColor(QPalette::WindowText, color);
+  return palette;
+}
+
+//------------------------------------------------------------------------------
+
+// painted indicators draw digits from one pixmap of glyphs per font,
+// shared by every indicator with the same font and pixel ratio
+
+class DigitGlyphAtlas
+{
+public:
+  static QSharedPointer<DigitGlyphAtlas> get(const QFont &font, qreal ratio)
+  {
+    static QHash<QString, QWeakPointer<DigitGlyphAtlas> > cache;
+    const QString key = font.key() + QString("@%1").arg(ratio);
+    QSharedPointer<DigitGlyphAtlas> atlas = cache.value(key).toStrongRef();
+    if(atlas) return atlas;
+    atlas.reset(new DigitGlyphAtlas(font, ratio));
+    cache.insert(key, atlas);
+    return atlas;
+  }
+
+  DigitGlyphAtlas(const QFont &font, qreal ratio): m_Font(font), m_Ratio(ratio)
+  {
+    int i, row, width = 0;
+    QFontMetrics fm(font);
+    for(i = 0; i < 10; ++i) width = qMax(width, fm.horizontalAdvance(QChar('0' + i)));
+    m_Cell = QSize(width, fm.height());
+
+    // row 0 holds the black glyphs and row 1 the light gray leading zeros
+    m_Pixmap = QPixmap(QSize(10 * m_Cell.width(), 2 * m_Cell.height()) * ratio);
+    m_Pixmap.setDevicePixelRatio(ratio);
+    m_Pixmap.fill(Qt::transparent);
+    QPainter painter(&m_Pixmap);
+    painter.setFont(font);
+    for(row = 0; row < 2; ++row)
+    {
+      painter.setPen(row ? QColor(Qt::lightGray) : QColor(Qt::black));
+      for(i = 0; i < 10; ++i)
+      {
+        painter.drawText(QRect(i * m_Cell.width(), row * m_Cell.height(), m_Cell.width(), m_Cell.height()), Qt::AlignCenter, QString::number(i));
+      }
+    }
+  }
+
+  void draw(QPainter &painter, const QRect &rect, int number, bool leading) const
+  {
+    // negative digits only appear with a negative minimum, draw them as text
+    if(number < 0 || number > 9)
+    {
+      painter.setFont(m_Font);
+      painter.setPen(leading ? QColor(Qt::lightGray) : QColor(Qt::black));
+      painter.drawText(rect, Qt::AlignCenter, QString::number(number));
+      return;
+    }
+    const QRectF target(rect.left() + (rect.width() - m_Cell.width()) / 2, rect.top() + (rect.height() - m_Cell.height()) / 2, m_Cell.width(), m_Cell.height());
+    const QRectF source(number * m_Cell.width() * m_Ratio, (leading ? 1 : 0) * m_Cell.height() * m_Ratio, m_Cell.width() * m_Ratio, m_Cell.height() * m_Ratio);
+    painter.drawPixmap(target, m_Pixmap, source);
+  }
+
+  QSize cellSize() const {return m_Cell;}
+  qreal ratio() const {return m_Ratio;}
+  qint64 bytes() const {return qint64(m_Pixmap.width()) * m_Pixmap.height() * m_Pixmap.depth() / 8;}
+
+private:
+  QFont m_Font;
+  qreal m_Ratio;
+  QSize m_Cell;
+  QPixmap m_Pixmap;
 };
 
 //------------------------------------------------------------------------------
@@ -23,7 +120,12 @@ static const QString c_StyleSheets[3] =
 class CustomDigit: public QLabel
 {
 public:
-  CustomDigit(QWidget *parent = 0): QLabel(parent), m_Active(true), m_State(0), m_Delta(0), m_Color(Qt::black) {}
+  CustomDigit(Indicator *parent): QLabel(parent), m_Active(true), m_State(0), m_Delta(0), m_Number(0), m_Leading(false), m_Indicator(parent)
+  {
+    setText(QString::number(0));
+    setAutoFillBackground(true);
+    applyPalette();
+  }
 
   void mouseMoveEvent(QMouseEvent *event)
   {
@@ -31,20 +133,21 @@ public:
     if(event->pos().y() < height() / 2 && m_State != 1)
     {
       m_State = 1;
-      applyStyleSheet();
+      applyPalette();
     }
     if(event->pos().y() > height() / 2 && m_State != 2)
     {
       m_State = 2;
-      applyStyleSheet();
+      applyPalette();
     }
   }
 
   void leaveEvent(QEvent *)
   {
     if(!m_Active) return;
+    if(m_State == 0) return;
     m_State = 0;
-    applyStyleSheet();
+    applyPalette();
   }
 
   void mousePressEvent(QMouseEvent *event)
@@ -67,28 +170,45 @@ public:
     event->accept();
   }
 
-  void applyStyleSheet(void)
+  void setNumber(int number, bool leading)
   {
-    setStyleSheet(c_StyleSheets[m_State].arg(m_Color.name()));
+    if(number != m_Number)
+    {
+      m_Number = number;
+      setText(QString::number(number));
+    }
+    if(leading != m_Leading)
+    {
+      m_Leading = leading;
+      applyPalette();
+    }
+  }
+
+  void applyPalette(void)
+  {
+    setPalette(m_Indicator->digitPalette(m_Leading, m_State));
   }
 
   bool m_Active;
   int m_State;
   qint64 m_Delta;
-  QColor m_Color;
+  int m_Number;
+  bool m_Leading;
   Indicator *m_Indicator;
 };
 
 //------------------------------------------------------------------------------
 
 Indicator::Indicator(QWidget *parent):
-  QFrame(parent), m_Layout(0), m_Font(), m_Size(0),
+  QFrame(parent), m_Layout(0), m_Painted(false),
+  m_Hover(-1), m_HoverState(0), m_DeltaMin(0), m_Font(), m_Size(0),
   m_Value(0), m_ValueMin(0), m_ValueMax(0)
 {
   m_Layout = new QHBoxLayout(this);
   m_Layout->setContentsMargins(1, 1, 1, 1);
   m_Layout->setSpacing(1);
   setLayout(m_Layout);
+  updatePalettes();
 }
 
 //------------------------------------------------------------------------------
@@ -99,13 +219,31 @@ Indicator::~Indicator()
 
 //------------------------------------------------------------------------------
 
+void Indicator::updatePalettes()
+{
+  for(int state = 0; state < 3; ++state)
+  {
+    m_Palettes[0][state] = makeDigitPalette(palette(), Qt::black, state);
+    m_Palettes[1][state] = makeDigitPalette(palette(), Qt::lightGray, state);
+  }
+}
+
+//------------------------------------------------------------------------------
+
 void Indicator::setFont(QFont font)
 {
   m_Font = font;
-  foreach(CustomDigit *digit, findChildren<CustomDigit *>())
+  foreach(CustomDigit *digit, m_Digits)
   {
     digit->setFont(font);
   }
+  if(m_Painted)
+  {
+    updateAtlas();
+    updateRects();
+    updateGeometry();
+    update();
+  }
 }
 
 //------------------------------------------------------------------------------
@@ -128,30 +266,45 @@ void Indicator::setSize(int size)
 
   width = fm.horizontalAdvance('m') / 5 + 1;
 
-  while((digit = findChild<CustomDigit *>()))
-  {
-    delete digit;
-  }
+  qDeleteAll(m_Digits);
+  m_Digits.clear();
   while((item = m_Layout->takeAt(0)))
   {
     delete item;
   }
 
-  m_Layout->addStretch();
+  m_Deltas.clear();
   for(i = size; i > 0; --i)
   {
-    digit = new CustomDigit(this);
-    digit->setText(QString::number(0));
-    digit->setAlignment(Qt::AlignCenter);
-    digit->setFont(m_Font);
-    m_Layout->addWidget(digit);
-    digit->setMouseTracking(true);
-    digit->m_Delta = qint64(qPow(10.0, i - 1) + 0.5);
-    digit->m_Indicator = this;
-    if(i > 1 && i % 3 == 1) m_Layout->addSpacing(width);
-  }
-  m_Layout->addStretch();
+    m_Deltas.append(qint64(qPow(10.0, i - 1) + 0.5));
+  }
+  m_Numbers.fill(0, size);
+  m_Leading.fill(false, size);
+  m_Hover = -1;
   m_Size = size;
+
+  if(m_Painted)
+  {
+    updateRects();
+    updateGeometry();
+    update();
+  }
+  else
+  {
+    m_Layout->addStretch();
+    for(i = size; i > 0; --i)
+    {
+      digit = new CustomDigit(this);
+      digit->setAlignment(Qt::AlignCenter);
+      digit->setFont(m_Font);
+      m_Layout->addWidget(digit);
+      m_Digits.append(digit);
+      digit->setMouseTracking(true);
+      digit->m_Delta = m_Deltas[size - i];
+      if(i > 1 && i % 3 == 1) m_Layout->addSpacing(width);
+    }
+    m_Layout->addStretch();
+  }
   setValue(m_Value);
 }
 
@@ -161,12 +314,24 @@ void Indicator::setValue(qint64 value)
 {
   qint64 quotient;
   if(value < m_ValueMin || value > m_ValueMax) return;
-  foreach(CustomDigit *digit, findChildren<CustomDigit *>())
+  foreach(CustomDigit *digit, m_Digits)
   {
     quotient = value / digit->m_Delta;
-    digit->m_Color = (quotient == 0)?Qt::lightGray:Qt::black;
-    digit->applyStyleSheet();
-    digit->setText(QString::number(quotient % 10));
+    digit->setNumber(int(quotient % 10), quotient == 0);
+  }
+  if(m_Painted)
+  {
+    // only repaint the digits that changed
+    for(int i = 0; i < m_Deltas.size(); ++i)
+    {
+      quotient = value / m_Deltas[i];
+      int number = int(quotient % 10);
+      bool leading = quotient == 0;
+      if(number == m_Numbers[i] && leading == m_Leading[i]) continue;
+      m_Numbers[i] = number;
+      m_Leading[i] = leading;
+      update(m_Rects.value(i));
+    }
   }
   m_Value = value;
   emit valueChanged(value);
@@ -194,11 +359,13 @@ void Indicator::setValueMax(qint64 value)
 
 void Indicator::setDeltaMin(qint64 delta)
 {
-  foreach(CustomDigit *digit, findChildren<CustomDigit *>())
+  m_DeltaMin = delta;
+  if(m_Hover >= 0 && m_Deltas[m_Hover] < delta) setHover(-1, 0);
+  foreach(CustomDigit *digit, m_Digits)
   {
     if(digit->m_Delta < delta)
     {
-      digit->setText(QString::number(0));
+      digit->setNumber(0, digit->m_Leading);
       digit->setMouseTracking(false);
       digit->m_Active = false;
     }
@@ -219,3 +386,180 @@ void Indicator::applyDelta(qint64 delta)
   if(delta > 0 && value > m_ValueMax) return;
   setValue(value);
 }
+
+//------------------------------------------------------------------------------
+
+void Indicator::setPainted(bool painted)
+{
+  if(painted == m_Painted) return;
+  m_Painted = painted;
+  setMouseTracking(painted);
+  if(painted) updateAtlas();
+  else m_Atlas.clear();
+  setSize(m_Size);
+}
+
+//------------------------------------------------------------------------------
+
+qint64 Indicator::atlasBytes() const
+{
+  return m_Atlas ? m_Atlas->bytes() : 0;
+}
+
+//------------------------------------------------------------------------------
+
+QSize Indicator::sizeHint() const
+{
+  return m_Painted ? m_ContentSize : QFrame::sizeHint();
+}
+
+//------------------------------------------------------------------------------
+
+QSize Indicator::minimumSizeHint() const
+{
+  return m_Painted ? m_ContentSize : QFrame::minimumSizeHint();
+}
+
+//------------------------------------------------------------------------------
+
+void Indicator::updateAtlas()
+{
+  m_Atlas = DigitGlyphAtlas::get(m_Font, devicePixelRatioF());
+}
+
+//------------------------------------------------------------------------------
+
+void Indicator::updateRects()
+{
+  int i, x, width, spacing;
+  QFontMetrics fm(m_Font);
+  QSize cell = m_Atlas ? m_Atlas->cellSize() : QSize();
+  QRect area = contentsRect().adjusted(1, 1, -1, -1);
+
+  // lay out the digits like the widget mode: 1 pixel apart, a space every 3 digits, centered
+  spacing = fm.horizontalAdvance('m') / 5 + 2;
+  width = 0;
+  for(i = m_Size; i > 0; --i)
+  {
+    width += cell.width();
+    if(i > 1) width += 1;
+    if(i > 1 && i % 3 == 1) width += spacing;
+  }
+  m_ContentSize = QSize(width, cell.height()) + QSize(2, 2) + QSize(2 * frameWidth(), 2 * frameWidth());
+
+  m_Rects.clear();
+  x = area.left() + qMax(0, (area.width() - width) / 2);
+  for(i = m_Size; i > 0; --i)
+  {
+    m_Rects.append(QRect(x, area.top(), cell.width(), area.height()));
+    x += cell.width() + 1;
+    if(i > 1 && i % 3 == 1) x += spacing;
+  }
+}
+
+//------------------------------------------------------------------------------
+
+int Indicator::digitAt(const QPoint &pos) const
+{
+  for(int i = 0; i < m_Rects.size(); ++i)
+  {
+    if(m_Rects[i].contains(pos)) return (m_Deltas[i] < m_DeltaMin) ? -1 : i;
+  }
+  return -1;
+}
+
+//------------------------------------------------------------------------------
+
+void Indicator::setHover(int index, int state)
+{
+  if(index == m_Hover && state == m_HoverState) return;
+  if(m_Hover >= 0) update(m_Rects.value(m_Hover));
+  m_Hover = index;
+  m_HoverState = state;
+  if(m_Hover >= 0) update(m_Rects.value(m_Hover));
+}
+
+//------------------------------------------------------------------------------
+
+void Indicator::paintEvent(QPaintEvent *event)
+{
+  QFrame::paintEvent(event);
+  if(!m_Painted) return;
+  if(!m_Atlas || m_Atlas->ratio() != devicePixelRatioF()) updateAtlas();
+
+  QPainter painter(this);
+  for(int i = 0; i < m_Rects.size(); ++i)
+  {
+    if(!event->rect().intersects(m_Rects[i])) continue;
+    if(i == m_Hover && m_HoverState != 0)
+    {
+      painter.fillRect(m_Rects[i], digitPalette(m_Leading[i], m_HoverState).brush(QPalette::Window));
+    }
+    m_Atlas->draw(painter, m_Rects[i], m_Numbers[i], m_Leading[i]);
+  }
+}
+
+//------------------------------------------------------------------------------
+
+void Indicator::resizeEvent(QResizeEvent *event)
+{
+  QFrame::resizeEvent(event);
+  if(m_Painted) updateRects();
+}
+
+//------------------------------------------------------------------------------
+
+void Indicator::mouseMoveEvent(QMouseEvent *event)
+{
+  int index = m_Painted ? digitAt(event->pos()) : -1;
+  if(index < 0)
+  {
+    if(m_Painted) setHover(-1, 0);
+    QFrame::mouseMoveEvent(event);
+    return;
+  }
+  int y = event->pos().y() - m_Rects[index].top();
+  int half = m_Rects[index].height() / 2;
+  int state = (index == m_Hover) ? m_HoverState : 0;
+  if(y < half) state = 1;
+  if(y > half) state = 2;
+  setHover(index, state);
+}
+
+//------------------------------------------------------------------------------
+
+void Indicator::mousePressEvent(QMouseEvent *event)
+{
+  int index = m_Painted ? digitAt(event->pos()) : -1;
+  if(index < 0)
+  {
+    QFrame::mousePressEvent(event);
+    return;
+  }
+  int y = event->pos().y() - m_Rects[index].top();
+  int half = m_Rects[index].height() / 2;
+  if(y < half) applyDelta(m_Deltas[index]);
+  if(y > half) applyDelta(-m_Deltas[index]);
+}
+
+//------------------------------------------------------------------------------
+
+void Indicator::wheelEvent(QWheelEvent *event)
+{
+  int index = m_Painted ? digitAt(mapFromGlobal(QCursor::pos())) : -1;
+  if(index < 0)
+  {
+    QFrame::wheelEvent(event);
+    return;
+  }
+  applyDelta(event->angleDelta().y() / 90 * m_Deltas[index]);
+  event->accept();
+}
+
+//------------------------------------------------------------------------------
+
+void Indicator::leaveEvent(QEvent *event)
+{
+  if(m_Painted) setHover(-1, 0);
+  QFrame::leaveEvent(event);
+}
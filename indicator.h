@@ -5,8 +5,13 @@
 #define Indicator_h
 
 #include <QtWidgets/QFrame>
+#include <QtGui/QPalette>
+#include <QtCore/QVector>
+#include <QtCore/QSharedPointer>
 
 class QHBoxLayout;
+class CustomDigit;
+class DigitGlyphAtlas;
 
 class Indicator: public QFrame
 {
@@ -26,12 +31,46 @@ public slots:
   void setValueMax(qint64 value);
   void setDeltaMin(qint64 delta);
   void applyDelta(qint64 delta);
+  void setPainted(bool painted);
+
+public:
+  const QPalette &digitPalette(bool leading, int state) const {return m_Palettes[leading?1:0][state];};
+  bool isPainted() const {return m_Painted;};
+  qint64 atlasBytes() const;
+  QSize sizeHint() const;
+  QSize minimumSizeHint() const;
+
+protected:
+  void paintEvent(QPaintEvent *event);
+  void resizeEvent(QResizeEvent *event);
+  void mouseMoveEvent(QMouseEvent *event);
+  void mousePressEvent(QMouseEvent *event);
+  void wheelEvent(QWheelEvent *event);
+  void leaveEvent(QEvent *event);
 
 signals:
   void valueChanged(qint64 value);
 
 private:
+  void updatePalettes();
+  void updateAtlas();
+  void updateRects();
+  int digitAt(const QPoint &pos) const;
+  void setHover(int index, int state);
+
   QHBoxLayout *m_Layout;
+  QVector<CustomDigit *> m_Digits;
+  QPalette m_Palettes[2][3];
+  bool m_Painted;
+  QSharedPointer<DigitGlyphAtlas> m_Atlas;
+  QVector<qint64> m_Deltas;
+  QVector<int> m_Numbers;
+  QVector<bool> m_Leading;
+  QVector<QRect> m_Rects;
+  QSize m_ContentSize;
+  int m_Hover;
+  int m_HoverState;
+  qint64 m_DeltaMin;
   QFont m_Font;
   int m_Size;
   qint64 m_Value;